@@ -250,6 +250,11 @@ else
   endif
 endif
 
+ifeq ($(strip $(EEPROM_WRITE_BEHIND_ENABLE)), yes)
+    OPT_DEFS += -DEEPROM_WRITE_BEHIND_ENABLE
+    SRC += $(PLATFORM_PATH)/eeprom_write_behind.c
+endif
+
 VALID_WEAR_LEVELING_DRIVER_TYPES := custom embedded_flash spi_flash rp2040_flash legacy
 WEAR_LEVELING_DRIVER ?= none
 ifneq ($(strip $(WEAR_LEVELING_DRIVER)),none)
@@ -638,6 +643,21 @@ ifneq ($(strip $(CUSTOM_MATRIX)), yes)
     endif
 endif
 
+MATRIX_BACKGROUND_SCAN_DRIVER ?= gpt
+VALID_MATRIX_BACKGROUND_SCAN_DRIVER_TYPES := gpt simulated custom
+ifeq ($(strip $(MATRIX_BACKGROUND_SCAN_ENABLE)), yes)
+    ifeq ($(filter $(MATRIX_BACKGROUND_SCAN_DRIVER),$(VALID_MATRIX_BACKGROUND_SCAN_DRIVER_TYPES)),)
+        $(call CATASTROPHIC_ERROR,Invalid MATRIX_BACKGROUND_SCAN_DRIVER,MATRIX_BACKGROUND_SCAN_DRIVER="$(MATRIX_BACKGROUND_SCAN_DRIVER)" is not a valid matrix background scan driver)
+    endif
+
+    OPT_DEFS += -DMATRIX_BACKGROUND_SCAN_ENABLE
+    QUANTUM_SRC += $(QUANTUM_DIR)/matrix_background.c
+
+    ifneq ($(strip $(MATRIX_BACKGROUND_SCAN_DRIVER)), custom)
+        SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/matrix_background_$(strip $(MATRIX_BACKGROUND_SCAN_DRIVER)).c
+    endif
+endif
+
 # Debounce Modules. Set DEBOUNCE_TYPE=custom if including one manually.
 DEBOUNCE_TYPE ?= sym_defer_g
 ifneq ($(strip $(DEBOUNCE_TYPE)), custom)
@@ -915,6 +935,12 @@ ifeq ($(strip $(DIP_SWITCH_ENABLE)), yes)
     endif
 endif
 
+ifeq ($(strip $(LEADER_ENABLE)), yes)
+    ifeq ($(strip $(LEADER_SEQUENCES_ENABLE)), yes)
+        OPT_DEFS += -DLEADER_SEQUENCES_ENABLE
+    endif
+endif
+
 VALID_WS2812_DRIVER_TYPES := bitbang custom i2c pwm spi vendor
 
 WS2812_DRIVER ?= bitbang
@@ -23,6 +23,7 @@ GENERIC_FEATURES = \
     AUTOCORRECT \
     BOOTMAGIC \
     CAPS_WORD \
+    CHORDS \
     COMBO \
     COMMAND \
     CRC \
@@ -36,11 +37,14 @@ GENERIC_FEATURES = \
     HAPTIC \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_TRACE \
     LEADER \
     MAGIC \
     MOUSEKEY \
     MUSIC \
     OS_DETECTION \
+    PROCESS_RECORD_PROFILER \
+    PROFILER \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
     SECURE \
@@ -49,6 +53,7 @@ GENERIC_FEATURES = \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TASK_SCHEDULER \
     TRI_LAYER \
     VIA \
     VIRTSER \
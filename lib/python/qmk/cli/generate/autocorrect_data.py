@@ -165,50 +165,91 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
+def minimize_trie(trie: Dict[str, Any]) -> Dict[str, Any]:
+    """Merges identical subtrees of the trie, turning it into a minimized DAWG.
+  Two subtrees are identical when they serialize to the same bytes, so leaves
+  are compared by their correction data rather than by their typo.
+  Args:
+    trie: Dict of dicts, as made by `make_trie`.
+  Returns:
+    Dict of dicts, where identical subtrees are the same object.
+  """
+    registry = {}
+
+    def merge(trie_node):
+        if 'LEAF' in trie_node:
+            key = tuple(encode_leaf(*trie_node['LEAF']))
+        else:
+            trie_node = {c: merge(child) for c, child in sorted(trie_node.items())}
+            key = tuple((c, id(child)) for c, child in trie_node.items())
+        return registry.setdefault(key, trie_node)
+
+    return merge(trie)
+
+
+def encode_leaf(typo: str, correction: str) -> List[int]:
+    """Encodes the backspaces and replacement text correcting `typo`."""
+    word_boundary_ending = typo[-1] == ':'
+    typo = typo.strip(':')
+    i = 0  # Make the autocorrection data for this entry and serialize it.
+    while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+        i += 1
+    backspaces = len(typo) - i - 1 + word_boundary_ending
+    assert 0 <= backspaces <= 63
+    correction = correction[i:]
+    return [backspaces + 128] + list(bytes(correction, 'ascii')) + [0]
+
+
+def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any], dawg: bool = False) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
+  With `dawg`, the trie is minimized first: each shared subtree is serialized
+  once and linked to from all of its parents, and chains are not terminated
+  when their child follows them.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
+    dawg: Whether to serialize a minimized DAWG rather than the plain trie.
   Returns:
     List of ints in the range 0-255.
   """
+    if dawg:
+        trie = minimize_trie(trie)
+
     table = []
+    # Links to the nodes already in the table, as (entry, offset) pairs.
+    emitted = {}
 
     # Traverse trie in depth first order.
     def traverse(trie_node):
+        if id(trie_node) in emitted:  # Handle a shared node.
+            return emitted[id(trie_node)]
+
+        node_id = id(trie_node)
         if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
-            word_boundary_ending = typo[-1] == ':'
-            typo = typo.strip(':')
-            i = 0  # Make the autocorrection data for this entry and serialize it.
-            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
-                i += 1
-            backspaces = len(typo) - i - 1 + word_boundary_ending
-            assert 0 <= backspaces <= 63
-            correction = correction[i:]
-            bs_count = [backspaces + 128]
-            data = bs_count + list(bytes(correction, 'ascii')) + [0]
-
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
+            entry = {'data': encode_leaf(*trie_node['LEAF']), 'links': [], 'byte_offset': 0}
+            emitted[node_id] = (entry, 0)
             table.append(entry)
         elif len(trie_node) == 1:  # Handle trie node with a single child.
-            c, trie_node = next(iter(trie_node.items()))
-            entry = {'chars': c, 'byte_offset': 0}
+            entry = {'chars': '', 'byte_offset': 0}
+            table.append(entry)
 
             # It's common for a trie to have long chains of single-child nodes. We
             # find the whole chain so that we can serialize it more efficiently.
-            while len(trie_node) == 1 and 'LEAF' not in trie_node:
+            # Nodes within the chain can be linked to by their offset into it.
+            while len(trie_node) == 1 and 'LEAF' not in trie_node and id(trie_node) not in emitted:
+                emitted[id(trie_node)] = (entry, len(entry['chars']))
                 c, trie_node = next(iter(trie_node.items()))
                 entry['chars'] += c
 
-            table.append(entry)
+            # The child follows the chain, unless it is already in the table.
+            entry['inline'] = id(trie_node) not in emitted
             entry['links'] = [traverse(trie_node)]
         else:  # Handle trie node with multiple children.
             entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
+            emitted[node_id] = (entry, 0)
             table.append(entry)
             entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
-        return entry
+        return emitted[node_id]
 
     traverse(trie)
 
@@ -216,7 +257,12 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
         if not e['links']:  # Handle a leaf table entry.
             return e['data']
         elif len(e['links']) == 1:  # Handle a chain table entry.
-            return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
+            data = [TYPO_CHARS[c] for c in e['chars']]
+            if not e['inline']:
+                return data + [1] + encode_link(e['links'][0])
+            # The child's first byte can't be mistaken for a keycode, so the
+            # terminator is only kept for the plain trie.
+            return data + ([] if dawg else [0])
         else:  # Handle a branch table entry.
             data = []
             for c, link in zip(e['chars'], e['links']):
@@ -232,15 +278,57 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
     return [b for e in table for b in serialize(e)]  # Serialize final table.
 
 
-def encode_link(link: Dict[str, Any]) -> List[int]:
+def encode_link(link: Tuple[Dict[str, Any], int]) -> List[int]:
     """Encodes a node link as two bytes."""
-    byte_offset = link['byte_offset']
+    entry, offset = link
+    byte_offset = entry['byte_offset'] + offset
     if not (0 <= byte_offset <= 0xffff):
         cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
         sys.exit(1)
     return [byte_offset & 255, byte_offset >> 8]
 
 
+def count_lookup_reads(autocorrections: List[Tuple[str, str]], data: List[int]) -> int:
+    """Counts the bytes read by process_autocorrect() while typing every typo.
+  This mirrors the decoder in process_autocorrect.c, as the number of flash
+  reads is what a lookup costs on the keyboard.
+  """
+    reads = 0
+    for typo, _ in autocorrections:
+        keys = [TYPO_CHARS[c] for c in typo]
+        for end in range(1, len(keys) + 1):
+            state = 0
+            code = data[state]
+            reads += 1
+            for key in reversed(keys[:end]):
+                if code & 64:
+                    code &= 63
+                    while code != key and code:
+                        state += 3
+                        code = data[state]
+                        reads += 1
+                    if not code:
+                        break
+                    state = data[state + 1] | data[state + 2] << 8
+                    reads += 2
+                elif code != key:
+                    break
+                else:
+                    state += 1
+                    code = data[state]
+                    reads += 1
+                    if not code:
+                        state += 1
+                    elif code == 1:
+                        state = data[state + 1] | data[state + 2] << 8
+                        reads += 2
+                code = data[state]
+                reads += 1
+                if code & 128:
+                    break
+    return reads
+
+
 def typo_len(e: Tuple[str, str]) -> int:
     return len(e[0])
 
@@ -254,12 +342,24 @@ def to_hex(b: int) -> str:
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-d', '--dawg', arg_only=True, action='store_true', help="Merge identical subtrees of the trie, to fit larger dictionaries")
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
     data = serialize_trie(autocorrections, trie)
 
+    if cli.args.dawg:
+        trie_data = data
+        data = serialize_trie(autocorrections, trie, dawg=True)
+
+        if not cli.args.quiet:
+            trie_reads = count_lookup_reads(autocorrections, trie_data)
+            dawg_reads = count_lookup_reads(autocorrections, data)
+            typed_keys = sum(len(typo) for typo, _ in autocorrections)
+            cli.log.info('Trie: %d bytes, %.2f bytes read per key', len(trie_data), trie_reads / typed_keys)
+            cli.log.info('DAWG: %d bytes, %.2f bytes read per key (%d%% smaller)', len(data), dawg_reads / typed_keys, 100 - 100 * len(data) // len(trie_data))
+
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
 
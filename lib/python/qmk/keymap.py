@@ -40,6 +40,10 @@ __ENCODER_MAP_GOES_HERE__
 
 __MACRO_OUTPUT_GOES_HERE__
 
+__CHORDS_GO_HERE__
+
+__LEADER_SEQUENCES_GO_HERE__
+
 """
 
 
@@ -125,6 +129,77 @@ def _generate_macros_function(keymap_json):
     return macro_txt
 
 
+def _generate_chords_table(keymap_json):
+    """Generates the flash tables used by the chording engine.
+
+    Every key used by a chord is given a bit, in order of first use. The chords are then sorted by mask, so that the firmware can binary search them.
+    """
+    chord_keys = []
+    for chord in keymap_json['chords']:
+        for key in chord['keys']:
+            if key not in chord_keys:
+                chord_keys.append(key)
+
+    chords = {}
+    for chord in keymap_json['chords']:
+        mask = 0
+        for key in chord['keys']:
+            mask |= 1 << chord_keys.index(key)
+        if mask in chords:
+            raise ValueError('Chord %s is defined more than once' % '+'.join(chord['keys']))
+        chords[mask] = chord
+
+    words = (len(chord_keys) + 31) // 32
+
+    lines = []
+    lines.append('#if defined(CHORDS_ENABLE)')
+    lines.append('const uint16_t PROGMEM chord_keys[] = {%s};' % ', '.join(chord_keys))
+    lines.append('')
+    lines.append('const chord_t PROGMEM key_chords[] = {')
+    for mask in sorted(chords):
+        chord = chords[mask]
+        mask_txt = ', '.join('0x%08X' % ((mask >> (32 * word)) & 0xFFFFFFFF) for word in range(words))
+        lines.append('    {{%s}, %s}, // %s' % (mask_txt, _strip_any(chord['keycode']), '+'.join(chord['keys'])))
+    lines.append('};')
+    lines.append('#endif // defined(CHORDS_ENABLE)')
+    return lines
+
+
+def _generate_leader_sequences_trie(keymap_json):
+    """Generates the flash trie of leader sequences.
+
+    Sequences sharing a prefix share the trie nodes for it. The nodes are written in pre-order, each with the number of nodes below it, so that the firmware can skip from one sibling to the next.
+    """
+    root = {}
+    for entry in keymap_json['leader_sequences']:
+        node = root
+        for key in entry['sequence']:
+            node = node.setdefault(key, {'children': {}, 'keycode': None})
+            result = node
+            node = node['children']
+        if result['keycode'] is not None:
+            raise ValueError('Leader sequence %s is defined more than once' % ' '.join(entry['sequence']))
+        result['keycode'] = entry['keycode']
+
+    def count(children):
+        return sum(1 + count(child['children']) for child in children.values())
+
+    def emit(children, prefix, lines):
+        for key, child in children.items():
+            sequence = prefix + [key]
+            keycode = _strip_any(child['keycode']) if child['keycode'] is not None else 'KC_NO'
+            lines.append('    {%s, %d, %s}, // %s' % (key, count(child['children']), keycode, ' '.join(sequence)))
+            emit(child['children'], sequence, lines)
+
+    lines = []
+    lines.append('#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)')
+    lines.append('const leader_sequence_node_t PROGMEM leader_sequences[] = {')
+    emit(root, [], lines)
+    lines.append('};')
+    lines.append('#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)')
+    return lines
+
+
 def _generate_keycodes_function(keymap_json):
     """Generates keymap level keycodes.
     """
@@ -327,6 +402,12 @@ def generate_c(keymap_json):
 
         macros
             A sequence of strings containing macros to implement for this keyboard.
+
+        chords
+            A sequence of chords, each with the `keys` to press together and the `keycode` to send.
+
+        leader_sequences
+            A sequence of leader sequences, each with the keys of the `sequence` and the `keycode` to send.
     """
     new_keymap = template_c(keymap_json['keyboard'])
     layer_txt = _generate_keymap_table(keymap_json)
@@ -350,6 +431,20 @@ def generate_c(keymap_json):
         hostlang = f'#include "keymap_{keymap_json["host_language"]}.h"\n#include "sendstring_{keymap_json["host_language"]}.h"\n'
     new_keymap = new_keymap.replace('__INCLUDES__', hostlang)
 
+    chords = ''
+    if 'chords' in keymap_json and keymap_json['chords']:
+        chords = '\n'.join(_generate_chords_table(keymap_json))
+        if '__CHORDS_GO_HERE__' not in new_keymap:
+            new_keymap += '\n__CHORDS_GO_HERE__\n'
+    new_keymap = new_keymap.replace('__CHORDS_GO_HERE__', chords)
+
+    leader_sequences = ''
+    if 'leader_sequences' in keymap_json and keymap_json['leader_sequences']:
+        leader_sequences = '\n'.join(_generate_leader_sequences_trie(keymap_json))
+        if '__LEADER_SEQUENCES_GO_HERE__' not in new_keymap:
+            new_keymap += '\n__LEADER_SEQUENCES_GO_HERE__\n'
+    new_keymap = new_keymap.replace('__LEADER_SEQUENCES_GO_HERE__', leader_sequences)
+
     keycodes = ''
     if 'keycodes' in keymap_json and keymap_json['keycodes'] is not None:
         keycodes_txt = _generate_keycodes_function(keymap_json)
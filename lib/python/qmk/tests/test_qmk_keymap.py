@@ -32,6 +32,36 @@ def test_generate_c_pytest_has_template():
     assert templ == '#include QMK_KEYBOARD_H\nconst uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {\t[0] = LAYOUT(KC_A)};\n'
 
 
+def test_generate_c_chords_sorted_by_mask():
+    keymap_json = {
+        'keyboard': 'handwired/pytest/basic',
+        'layout': 'LAYOUT_ortho_1x1',
+        'layers': [['KC_A']],
+        'chords': [
+            {'keys': ['KC_S', 'KC_T'], 'keycode': 'KC_A'},
+            {'keys': ['KC_S'], 'keycode': 'KC_B'},
+        ],
+    }
+    templ = qmk.keymap.generate_c(keymap_json)
+    assert 'const uint16_t PROGMEM chord_keys[] = {KC_S, KC_T};' in templ
+    assert templ.index('{{0x00000001}, KC_B}') < templ.index('{{0x00000003}, KC_A}')
+
+
+def test_generate_c_leader_sequences_trie():
+    keymap_json = {
+        'keyboard': 'handwired/pytest/basic',
+        'layout': 'LAYOUT_ortho_1x1',
+        'layers': [['KC_A']],
+        'leader_sequences': [
+            {'sequence': ['KC_A', 'KC_B'], 'keycode': 'KC_1'},
+            {'sequence': ['KC_C'], 'keycode': 'KC_2'},
+            {'sequence': ['KC_A'], 'keycode': 'KC_3'},
+        ],
+    }
+    templ = qmk.keymap.generate_c(keymap_json)
+    assert '    {KC_A, 1, KC_3}, // KC_A\n    {KC_B, 0, KC_1}, // KC_A KC_B\n    {KC_C, 0, KC_2}, // KC_C\n' in templ
+
+
 def test_generate_json_pytest_has_template():
     templ = qmk.keymap.generate_json('default', 'handwired/pytest/has_template', 'LAYOUT', [['KC_A']])
     assert templ == {"keyboard": "handwired/pytest/has_template", "documentation": "This file is a keymap.json file for handwired/pytest/has_template", "keymap": "default", "layout": "LAYOUT", "layers": [["KC_A"]]}
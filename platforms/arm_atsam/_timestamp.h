@@ -0,0 +1,18 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "samd51j18a.h"
+#include "tmk_core/protocol/arm_atsam/clks.h"
+
+// DWT cycle counter, clocked by the core (DPLL0)
+#define TIMESTAMP_FREQUENCY (system_clks.freq_gclk[GEN_DPLL0])
+
+static inline timestamp_t timestamp_read(void) {
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+}
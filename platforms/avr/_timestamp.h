@@ -0,0 +1,36 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <avr/io.h>
+#include <util/atomic.h>
+#include "timer_avr.h"
+
+extern volatile uint32_t timer_count;
+
+// Timer0 runs in CTC mode, wrapping every millisecond
+#define TIMESTAMP_TICKS_PER_MS (TIMER_RAW_TOP + 1UL)
+#define TIMESTAMP_FREQUENCY (TIMESTAMP_TICKS_PER_MS * 1000UL)
+
+#if defined(__AVR_ATmega32A__)
+#    define TIMESTAMP_COMPARE_PENDING() (TIFR & _BV(OCF0))
+#elif defined(__AVR_ATtiny85__)
+#    define TIMESTAMP_COMPARE_PENDING() (TIFR & _BV(OCF0A))
+#else
+#    define TIMESTAMP_COMPARE_PENDING() (TIFR0 & _BV(OCF0A))
+#endif
+
+static inline timestamp_t timestamp_read(void) {
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        raw = TIMER_RAW;
+        ms  = timer_count;
+        // The counter may have wrapped before the compare interrupt could run
+        if (TIMESTAMP_COMPARE_PENDING()) {
+            raw = TIMER_RAW;
+            ms++;
+        }
+    }
+    return ms * TIMESTAMP_TICKS_PER_MS + raw;
+}
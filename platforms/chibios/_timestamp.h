@@ -0,0 +1,21 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <ch.h>
+#include "chibios_config.h"
+
+#if PORT_SUPPORTS_RT == TRUE
+#    define TIMESTAMP_FREQUENCY REALTIME_COUNTER_CLOCK
+
+static inline timestamp_t timestamp_read(void) {
+    return (timestamp_t)chSysGetRealtimeCounterX();
+}
+#else
+// No cycle counter available (e.g. Cortex-M0), fall back to the system tick
+#    define TIMESTAMP_FREQUENCY CH_CFG_ST_FREQUENCY
+
+static inline timestamp_t timestamp_read(void) {
+    return (timestamp_t)chVTGetSystemTimeX();
+}
+#endif
@@ -0,0 +1,52 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+#include "matrix_background.h"
+
+#ifndef MATRIX_BACKGROUND_SCAN_TIMER
+#    define MATRIX_BACKGROUND_SCAN_TIMER GPTD7
+#endif
+
+#ifndef MATRIX_BACKGROUND_SCAN_TIMER_FREQUENCY
+#    define MATRIX_BACKGROUND_SCAN_TIMER_FREQUENCY 1000000
+#endif
+
+#ifndef MATRIX_BACKGROUND_SCAN_THREAD_PRIORITY
+#    define MATRIX_BACKGROUND_SCAN_THREAD_PRIORITY (NORMALPRIO + 16)
+#endif
+
+static binary_semaphore_t scan_semaphore;
+static THD_WORKING_AREA(matrix_scan_thread_wa, 256);
+
+// Only wakes the scan thread: strobing involves locking and settle delays,
+// which are better done outside of the interrupt
+static void matrix_scan_timer_cb(GPTDriver *gptp) {
+    (void)gptp;
+    chSysLockFromISR();
+    chBSemSignalI(&scan_semaphore);
+    chSysUnlockFromISR();
+}
+
+static const GPTConfig matrix_scan_timer_config = {
+    .frequency = MATRIX_BACKGROUND_SCAN_TIMER_FREQUENCY,
+    .callback  = matrix_scan_timer_cb,
+};
+
+static THD_FUNCTION(matrix_scan_thread, arg) {
+    (void)arg;
+    chRegSetThreadName("matrix_scan");
+    while (true) {
+        chBSemWait(&scan_semaphore);
+        matrix_background_scan();
+    }
+}
+
+void matrix_background_driver_init(void) {
+    chBSemObjectInit(&scan_semaphore, true);
+    chThdCreateStatic(matrix_scan_thread_wa, sizeof(matrix_scan_thread_wa), MATRIX_BACKGROUND_SCAN_THREAD_PRIORITY, matrix_scan_thread, NULL);
+
+    gptStart(&MATRIX_BACKGROUND_SCAN_TIMER, &matrix_scan_timer_config);
+    gptStartContinuous(&MATRIX_BACKGROUND_SCAN_TIMER, MATRIX_BACKGROUND_SCAN_TIMER_FREQUENCY / MATRIX_BACKGROUND_SCAN_RATE);
+}
@@ -0,0 +1,171 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "eeprom.h"
+#include "eeprom_write_behind.h"
+#include "timer.h"
+
+_Static_assert(EEPROM_WRITE_BEHIND_SIZE <= UINT16_MAX, "EEPROM_WRITE_BEHIND_SIZE must fit in 16 bits");
+_Static_assert(EEPROM_WRITE_BEHIND_RANGES > 0 && EEPROM_WRITE_BEHIND_RANGES <= UINT8_MAX, "EEPROM_WRITE_BEHIND_RANGES must be between 1 and 255");
+
+typedef struct {
+    uint16_t addr;
+    uint16_t len;
+} write_behind_range_t;
+
+// Dirty ranges, sorted by address and never touching each other. Their bytes
+// are packed into the pool in the same order.
+static write_behind_range_t ranges[EEPROM_WRITE_BEHIND_RANGES];
+static uint8_t              range_count = 0;
+static uint8_t              pool[EEPROM_WRITE_BEHIND_SIZE];
+static uint16_t             pool_used   = 0;
+static uint16_t             last_update = 0;
+
+void eeprom_write_behind_read_block(void *buf, const void *addr, size_t len) {
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end   = start + len;
+    uint8_t * bytes = buf;
+    uint16_t  data  = 0;
+
+    eeprom_read_block(buf, addr, len);
+    for (uint8_t i = 0; i < range_count; data += ranges[i].len, i++) {
+        uintptr_t from = ranges[i].addr > start ? ranges[i].addr : start;
+        uintptr_t to   = ranges[i].addr + ranges[i].len < end ? ranges[i].addr + ranges[i].len : end;
+        if (from < to) {
+            memcpy(&bytes[from - start], &pool[data + (from - ranges[i].addr)], to - from);
+        }
+    }
+}
+
+void eeprom_write_behind_sync(void) {
+    uint16_t data = 0;
+    for (uint8_t i = 0; i < range_count; i++) {
+        eeprom_update_block(&pool[data], (void *)(uintptr_t)ranges[i].addr, ranges[i].len);
+        data += ranges[i].len;
+    }
+    eeprom_write_behind_discard();
+}
+
+void eeprom_write_behind_discard(void) {
+    range_count = 0;
+    pool_used   = 0;
+}
+
+void eeprom_write_behind_task(void) {
+    if (range_count > 0 && timer_elapsed(last_update) >= EEPROM_WRITE_BEHIND_IDLE_TIMEOUT) {
+        eeprom_write_behind_sync();
+    }
+}
+
+// Finds the ranges [*first, *last) that overlap or touch [start, end), and
+// the pool offset and byte count they currently take up
+static void find_touching_ranges(uintptr_t start, uintptr_t end, uint8_t *first, uint8_t *last, uint16_t *data, uint16_t *merged_len) {
+    *data       = 0;
+    *merged_len = 0;
+    *first      = 0;
+    while (*first < range_count && ranges[*first].addr + ranges[*first].len < start) {
+        *data += ranges[*first].len;
+        (*first)++;
+    }
+    *last = *first;
+    while (*last < range_count && ranges[*last].addr <= end) {
+        *merged_len += ranges[*last].len;
+        (*last)++;
+    }
+}
+
+void eeprom_write_behind_update_block(const void *buf, void *addr, size_t len) {
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end   = start + len;
+
+    if (len == 0) {
+        return;
+    }
+    if (len > EEPROM_WRITE_BEHIND_SIZE) {
+        // Too big to hold back; anything pending underneath is superseded
+        eeprom_write_behind_sync();
+        eeprom_update_block(buf, addr, len);
+        return;
+    }
+
+    // Nothing to do if the bytes already read back the same
+    uint8_t current[len];
+    eeprom_write_behind_read_block(current, addr, len);
+    if (memcmp(current, buf, len) == 0) {
+        return;
+    }
+    last_update = timer_read();
+
+    uint8_t  first, last;
+    uint16_t data, merged_len;
+    find_touching_ranges(start, end, &first, &last, &data, &merged_len);
+
+    uintptr_t new_start = first < last && ranges[first].addr < start ? ranges[first].addr : start;
+    uintptr_t new_end   = first < last && ranges[last - 1].addr + ranges[last - 1].len > end ? ranges[last - 1].addr + ranges[last - 1].len : end;
+    uint16_t  new_len   = new_end - new_start;
+
+    if (pool_used - merged_len + new_len > EEPROM_WRITE_BEHIND_SIZE || (first == last && range_count == EEPROM_WRITE_BEHIND_RANGES)) {
+        // Out of space, start over with just this update
+        eeprom_write_behind_sync();
+        first = last = 0;
+        data = merged_len = 0;
+        new_start         = start;
+        new_len           = len;
+    }
+
+    // Make room for the merged range, then spread the bytes of the ranges it
+    // swallows out to their place within it, last first so nothing is
+    // overwritten before it has moved. The gaps between them are all covered
+    // by the new bytes.
+    memmove(&pool[data + new_len], &pool[data + merged_len], pool_used - data - merged_len);
+    uint16_t source = data + merged_len;
+    for (uint8_t i = last; i > first; i--) {
+        source -= ranges[i - 1].len;
+        memmove(&pool[data + (ranges[i - 1].addr - new_start)], &pool[source], ranges[i - 1].len);
+    }
+    memcpy(&pool[data + (start - new_start)], buf, len);
+    pool_used = pool_used - merged_len + new_len;
+
+    if (first == last) {
+        memmove(&ranges[first + 1], &ranges[first], (range_count - first) * sizeof(write_behind_range_t));
+        range_count++;
+    } else {
+        memmove(&ranges[first + 1], &ranges[last], (range_count - last) * sizeof(write_behind_range_t));
+        range_count -= last - first - 1;
+    }
+    ranges[first].addr = new_start;
+    ranges[first].len  = new_len;
+}
+
+uint8_t eeprom_write_behind_read_byte(const uint8_t *addr) {
+    uint8_t value;
+    eeprom_write_behind_read_block(&value, addr, sizeof(value));
+    return value;
+}
+
+uint16_t eeprom_write_behind_read_word(const uint16_t *addr) {
+    uint16_t value;
+    eeprom_write_behind_read_block(&value, addr, sizeof(value));
+    return value;
+}
+
+uint32_t eeprom_write_behind_read_dword(const uint32_t *addr) {
+    uint32_t value;
+    eeprom_write_behind_read_block(&value, addr, sizeof(value));
+    return value;
+}
+
+void eeprom_write_behind_update_byte(uint8_t *addr, uint8_t value) {
+    eeprom_write_behind_update_block(&value, addr, sizeof(value));
+}
+
+void eeprom_write_behind_update_word(uint16_t *addr, uint16_t value) {
+    eeprom_write_behind_update_block(&value, addr, sizeof(value));
+}
+
+void eeprom_write_behind_update_dword(uint32_t *addr, uint32_t value) {
+    eeprom_write_behind_update_block(&value, addr, sizeof(value));
+}
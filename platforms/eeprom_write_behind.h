@@ -0,0 +1,81 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef EEPROM_WRITE_BEHIND_SIZE
+#    define EEPROM_WRITE_BEHIND_SIZE 64
+#endif
+
+#ifndef EEPROM_WRITE_BEHIND_RANGES
+#    define EEPROM_WRITE_BEHIND_RANGES 4
+#endif
+
+#ifndef EEPROM_WRITE_BEHIND_IDLE_TIMEOUT
+#    define EEPROM_WRITE_BEHIND_IDLE_TIMEOUT 1000
+#endif
+
+/**
+ * Write-behind cache on top of the EEPROM driver.
+ *
+ * Updates are held in RAM as ranges of dirty bytes, with overlapping and
+ * adjacent updates merged into one range, and written to the driver once no
+ * update has arrived for EEPROM_WRITE_BEHIND_IDLE_TIMEOUT milliseconds, when
+ * the cache runs out of space, or on eeprom_write_behind_sync(). Reads
+ * through the cache see pending updates.
+ *
+ * Only accesses made through these functions are cached, so everything that
+ * touches the eeconfig area uses them. Without EEPROM_WRITE_BEHIND_ENABLE
+ * they go straight to the driver.
+ */
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+uint8_t  eeprom_write_behind_read_byte(const uint8_t *addr);
+uint16_t eeprom_write_behind_read_word(const uint16_t *addr);
+uint32_t eeprom_write_behind_read_dword(const uint32_t *addr);
+void     eeprom_write_behind_read_block(void *buf, const void *addr, size_t len);
+void     eeprom_write_behind_update_byte(uint8_t *addr, uint8_t value);
+void     eeprom_write_behind_update_word(uint16_t *addr, uint16_t value);
+void     eeprom_write_behind_update_dword(uint32_t *addr, uint32_t value);
+void     eeprom_write_behind_update_block(const void *buf, void *addr, size_t len);
+
+/** Writes all pending updates to the EEPROM driver. */
+void eeprom_write_behind_sync(void);
+
+/** Drops all pending updates, e.g. when the EEPROM is about to be erased. */
+void eeprom_write_behind_discard(void);
+
+/** Syncs once the cache has been idle for EEPROM_WRITE_BEHIND_IDLE_TIMEOUT. */
+void eeprom_write_behind_task(void);
+#else
+#    include "eeprom.h"
+
+static inline uint8_t eeprom_write_behind_read_byte(const uint8_t *addr) {
+    return eeprom_read_byte(addr);
+}
+static inline uint16_t eeprom_write_behind_read_word(const uint16_t *addr) {
+    return eeprom_read_word(addr);
+}
+static inline uint32_t eeprom_write_behind_read_dword(const uint32_t *addr) {
+    return eeprom_read_dword(addr);
+}
+static inline void eeprom_write_behind_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_read_block(buf, addr, len);
+}
+static inline void eeprom_write_behind_update_byte(uint8_t *addr, uint8_t value) {
+    eeprom_update_byte(addr, value);
+}
+static inline void eeprom_write_behind_update_word(uint16_t *addr, uint16_t value) {
+    eeprom_update_word(addr, value);
+}
+static inline void eeprom_write_behind_update_dword(uint32_t *addr, uint32_t value) {
+    eeprom_update_dword(addr, value);
+}
+static inline void eeprom_write_behind_update_block(const void *buf, void *addr, size_t len) {
+    eeprom_update_block(buf, addr, len);
+}
+static inline void eeprom_write_behind_sync(void) {}
+static inline void eeprom_write_behind_discard(void) {}
+static inline void eeprom_write_behind_task(void) {}
+#endif
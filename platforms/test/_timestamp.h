@@ -0,0 +1,14 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <time.h>
+
+// Host monotonic clock, in nanoseconds
+#define TIMESTAMP_FREQUENCY 1000000000UL
+
+static inline timestamp_t timestamp_read(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (timestamp_t)((uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec);
+}
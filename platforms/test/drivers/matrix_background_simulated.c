@@ -0,0 +1,50 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "matrix_background.h"
+#include "matrix_background_simulated.h"
+
+static matrix_row_t switches[MATRIX_ROWS];
+static bool         running = false;
+static void (*line_callback)(uint8_t line);
+
+void matrix_background_driver_init(void) {
+    running = true;
+}
+
+// Simulated COL2ROW hardware, for when no matrix implementation is linked in
+__attribute__((weak)) void matrix_background_read_line(matrix_row_t matrix[], uint8_t line) {
+    matrix[line] = switches[line];
+    if (line_callback) {
+        line_callback(line);
+    }
+}
+
+void matrix_background_simulated_set_key(uint8_t row, uint8_t col, bool pressed) {
+    if (pressed) {
+        switches[row] |= MATRIX_ROW_SHIFTER << col;
+    } else {
+        switches[row] &= ~(MATRIX_ROW_SHIFTER << col);
+    }
+}
+
+void matrix_background_simulated_tick(uint32_t count) {
+    while (running && count--) {
+        matrix_background_scan();
+    }
+}
+
+void matrix_background_simulated_on_line(void (*callback)(uint8_t line)) {
+    line_callback = callback;
+}
+
+bool matrix_background_simulated_is_running(void) {
+    return running;
+}
+
+void matrix_background_simulated_reset(void) {
+    memset(switches, 0, sizeof(switches));
+    running       = false;
+    line_callback = NULL;
+}
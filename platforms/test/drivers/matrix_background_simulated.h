@@ -0,0 +1,26 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Sets the state of a simulated switch. */
+void matrix_background_simulated_set_key(uint8_t row, uint8_t col, bool pressed);
+/* Fires the simulated scan timer `count` times. */
+void matrix_background_simulated_tick(uint32_t count);
+/* Registers a callback run after each line is strobed, or NULL to clear it. */
+void matrix_background_simulated_on_line(void (*callback)(uint8_t line));
+/* Whether matrix_background_driver_init() has been called. */
+bool matrix_background_simulated_is_running(void);
+/* Stops the simulated timer and releases all switches. */
+void matrix_background_simulated_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,182 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "eeprom_write_behind.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+// Stands in for the EEPROM driver, counting the writes that reach it
+static uint8_t backing[256];
+static int     backing_writes = 0;
+
+extern "C" void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    memcpy(buf, &backing[(uintptr_t)addr], len);
+}
+
+extern "C" void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    memcpy(&backing[(uintptr_t)addr], buf, len);
+    backing_writes++;
+}
+
+static uint8_t *address(uintptr_t offset) {
+    return (uint8_t *)offset;
+}
+
+class EepromWriteBehind : public testing::Test {
+   protected:
+    void SetUp() override {
+        eeprom_write_behind_discard();
+        memset(backing, 0, sizeof(backing));
+        backing_writes = 0;
+        timer_clear();
+    }
+};
+
+TEST_F(EepromWriteBehind, ReadsSeePendingUpdates) {
+    eeprom_write_behind_update_byte(address(10), 0x12);
+    eeprom_write_behind_update_dword((uint32_t *)address(20), 0xDEADBEEF);
+
+    EXPECT_EQ(eeprom_write_behind_read_byte(address(10)), 0x12);
+    EXPECT_EQ(eeprom_write_behind_read_dword((const uint32_t *)address(20)), 0xDEADBEEF);
+    EXPECT_EQ(eeprom_write_behind_read_word((const uint16_t *)address(22)), 0xDEAD);
+    EXPECT_EQ(backing[10], 0);
+    EXPECT_EQ(backing_writes, 0);
+
+    // A read straddling a pending range and clean bytes
+    backing[9]  = 0x34;
+    backing[11] = 0x56;
+    uint8_t bytes[3];
+    eeprom_write_behind_read_block(bytes, address(9), sizeof(bytes));
+    EXPECT_EQ(bytes[0], 0x34);
+    EXPECT_EQ(bytes[1], 0x12);
+    EXPECT_EQ(bytes[2], 0x56);
+}
+
+TEST_F(EepromWriteBehind, BurstIsWrittenOnceIdle) {
+    // A slider being dragged
+    for (uint32_t value = 1; value <= 50; value++) {
+        eeprom_write_behind_update_dword((uint32_t *)address(40), value);
+        advance_time(EEPROM_WRITE_BEHIND_IDLE_TIMEOUT / 4);
+        eeprom_write_behind_task();
+    }
+    EXPECT_EQ(backing_writes, 0);
+
+    advance_time(EEPROM_WRITE_BEHIND_IDLE_TIMEOUT);
+    eeprom_write_behind_task();
+    EXPECT_EQ(backing_writes, 1);
+    uint32_t value;
+    memcpy(&value, &backing[40], sizeof(value));
+    EXPECT_EQ(value, 50);
+}
+
+TEST_F(EepromWriteBehind, TouchingUpdatesAreMerged) {
+    eeprom_write_behind_update_byte(address(12), 3);
+    eeprom_write_behind_update_byte(address(10), 1);
+    eeprom_write_behind_update_byte(address(11), 2);
+    eeprom_write_behind_update_word((uint16_t *)address(12), 0x0403);
+    eeprom_write_behind_update_byte(address(14), 5);
+
+    eeprom_write_behind_sync();
+    EXPECT_EQ(backing_writes, 1);
+    for (uint8_t i = 0; i < 5; i++) {
+        EXPECT_EQ(backing[10 + i], i + 1);
+    }
+}
+
+TEST_F(EepromWriteBehind, UpdateSpanningGapsSwallowsRanges) {
+    eeprom_write_behind_update_byte(address(0), 0xA0);
+    eeprom_write_behind_update_byte(address(3), 0xA3);
+    eeprom_write_behind_update_byte(address(6), 0xA6);
+
+    const uint8_t middle[] = {0xB2, 0xB3, 0xB4};
+    eeprom_write_behind_update_block(middle, address(2), sizeof(middle));
+    eeprom_write_behind_update_byte(address(1), 0xB1);
+    eeprom_write_behind_update_byte(address(5), 0xB5);
+    // Only fits if the others have become one range
+    eeprom_write_behind_update_byte(address(100), 0xFF);
+    EXPECT_EQ(backing_writes, 0);
+
+    const uint8_t expected[] = {0xA0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xA6};
+    uint8_t       read[sizeof(expected)];
+    eeprom_write_behind_read_block(read, address(0), sizeof(read));
+    EXPECT_EQ(memcmp(read, expected, sizeof(expected)), 0);
+    EXPECT_EQ(eeprom_write_behind_read_byte(address(100)), 0xFF);
+
+    eeprom_write_behind_sync();
+    EXPECT_EQ(backing_writes, 2);
+    EXPECT_EQ(memcmp(backing, expected, sizeof(expected)), 0);
+    EXPECT_EQ(backing[100], 0xFF);
+}
+
+TEST_F(EepromWriteBehind, UnchangedBytesAreNotWritten) {
+    backing[30] = 0x42;
+    eeprom_write_behind_update_byte(address(30), 0x42);
+    eeprom_write_behind_sync();
+    EXPECT_EQ(backing_writes, 0);
+
+    // Changing a byte back before it is written still writes it once
+    eeprom_write_behind_update_byte(address(30), 0x43);
+    eeprom_write_behind_update_byte(address(30), 0x42);
+    eeprom_write_behind_sync();
+    EXPECT_EQ(backing_writes, 1);
+    EXPECT_EQ(backing[30], 0x42);
+}
+
+TEST_F(EepromWriteBehind, SyncsWhenOutOfRanges) {
+    for (uint8_t i = 0; i < EEPROM_WRITE_BEHIND_RANGES; i++) {
+        eeprom_write_behind_update_byte(address(i * 10), i + 1);
+    }
+    EXPECT_EQ(backing_writes, 0);
+
+    eeprom_write_behind_update_byte(address(200), 0x99);
+    EXPECT_EQ(backing_writes, EEPROM_WRITE_BEHIND_RANGES);
+    EXPECT_EQ(backing[200], 0);
+    EXPECT_EQ(eeprom_write_behind_read_byte(address(200)), 0x99);
+    for (uint8_t i = 0; i < EEPROM_WRITE_BEHIND_RANGES; i++) {
+        EXPECT_EQ(backing[i * 10], i + 1);
+    }
+}
+
+TEST_F(EepromWriteBehind, SyncsWhenOutOfSpace) {
+    uint8_t block[EEPROM_WRITE_BEHIND_SIZE - 2];
+    memset(block, 0x11, sizeof(block));
+    eeprom_write_behind_update_block(block, address(0), sizeof(block));
+    EXPECT_EQ(backing_writes, 0);
+
+    const uint8_t more[] = {0x22, 0x22, 0x22, 0x22};
+    eeprom_write_behind_update_block(more, address(100), sizeof(more));
+    EXPECT_EQ(backing_writes, 1);
+    EXPECT_EQ(backing[0], 0x11);
+    EXPECT_EQ(eeprom_write_behind_read_byte(address(103)), 0x22);
+}
+
+TEST_F(EepromWriteBehind, LargeUpdatesWriteThrough) {
+    eeprom_write_behind_update_byte(address(5), 0x55);
+
+    uint8_t block[EEPROM_WRITE_BEHIND_SIZE + 1];
+    memset(block, 0x66, sizeof(block));
+    eeprom_write_behind_update_block(block, address(0), sizeof(block));
+    EXPECT_EQ(backing_writes, 2);
+    EXPECT_EQ(backing[5], 0x66);
+
+    // Nothing stale is left to be written later
+    eeprom_write_behind_sync();
+    EXPECT_EQ(backing_writes, 2);
+    EXPECT_EQ(backing[5], 0x66);
+}
+
+TEST_F(EepromWriteBehind, DiscardDropsPendingUpdates) {
+    eeprom_write_behind_update_byte(address(7), 0x77);
+    eeprom_write_behind_discard();
+    EXPECT_EQ(eeprom_write_behind_read_byte(address(7)), 0);
+
+    eeprom_write_behind_sync();
+    EXPECT_EQ(backing_writes, 0);
+}
@@ -0,0 +1,88 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix_background.h"
+#include "matrix_background_simulated.h"
+}
+
+class MatrixBackground : public testing::Test {
+   protected:
+    void SetUp() override {
+        matrix_background_simulated_reset();
+        matrix_background_init(MATRIX_ROWS, MATRIX_ROWS);
+    }
+    void TearDown() override {
+        matrix_background_simulated_reset();
+    }
+};
+
+TEST_F(MatrixBackground, InitStartsDriver) {
+    matrix_row_t snapshot[MATRIX_ROWS] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+    EXPECT_TRUE(matrix_background_simulated_is_running());
+    EXPECT_FALSE(matrix_background_read(snapshot));
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(snapshot[row], 0);
+    }
+}
+
+TEST_F(MatrixBackground, SnapshotIsPublishedAfterEachPass) {
+    matrix_row_t snapshot[MATRIX_ROWS];
+
+    matrix_background_simulated_set_key(1, 2, true);
+    EXPECT_FALSE(matrix_background_read(snapshot));
+    EXPECT_EQ(snapshot[1], 0);
+
+    matrix_background_simulated_tick(1);
+    EXPECT_TRUE(matrix_background_read(snapshot));
+    EXPECT_EQ(snapshot[1], 1 << 2);
+
+    // Nothing new until the next pass, but the snapshot is still available
+    EXPECT_FALSE(matrix_background_read(snapshot));
+    EXPECT_EQ(snapshot[1], 1 << 2);
+}
+
+static matrix_row_t mid_pass_snapshot[MATRIX_ROWS];
+
+TEST_F(MatrixBackground, PartialPassIsNotVisible) {
+    matrix_row_t snapshot[MATRIX_ROWS];
+
+    matrix_background_simulated_set_key(0, 0, true);
+    matrix_background_simulated_tick(1);
+
+    matrix_background_simulated_set_key(0, 0, false);
+    matrix_background_simulated_set_key(3, 3, true);
+    matrix_background_simulated_on_line([](uint8_t line) {
+        if (line == 2) {
+            matrix_background_read(mid_pass_snapshot);
+        }
+    });
+    matrix_background_simulated_tick(1);
+
+    // Row 0 has already been rescanned, but only the previous pass is visible
+    EXPECT_EQ(mid_pass_snapshot[0], 1 << 0);
+    EXPECT_EQ(mid_pass_snapshot[3], 0);
+
+    EXPECT_TRUE(matrix_background_read(snapshot));
+    EXPECT_EQ(snapshot[0], 0);
+    EXPECT_EQ(snapshot[3], 1 << 3);
+}
+
+TEST_F(MatrixBackground, ScanCountFollowsTimer) {
+    matrix_row_t snapshot[MATRIX_ROWS];
+
+    matrix_background_simulated_tick(5);
+    EXPECT_EQ(matrix_background_scan_count(), 5);
+
+    // Changes between reads are only seen through the latest pass
+    matrix_background_simulated_set_key(2, 7, true);
+    matrix_background_simulated_tick(1);
+    matrix_background_simulated_set_key(2, 7, false);
+    matrix_background_simulated_tick(1);
+    EXPECT_TRUE(matrix_background_read(snapshot));
+    EXPECT_EQ(snapshot[2], 0);
+    EXPECT_EQ(matrix_background_scan_count(), 7);
+}
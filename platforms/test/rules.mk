@@ -23,3 +23,16 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+matrix_background_DEFS := -DMATRIX_ROWS=4 -DMATRIX_COLS=8 -DIGNORE_ATOMIC_BLOCK
+matrix_background_INC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers
+matrix_background_SRC := \
+	$(QUANTUM_PATH)/matrix_background.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/matrix_background_simulated.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_background_tests.cpp
+
+eeprom_write_behind_DEFS := -DEEPROM_TEST_HARNESS -DEEPROM_WRITE_BEHIND_ENABLE -DEEPROM_WRITE_BEHIND_SIZE=16 -DEEPROM_WRITE_BEHIND_RANGES=3 -DEEPROM_WRITE_BEHIND_IDLE_TIMEOUT=100
+eeprom_write_behind_SRC := \
+	$(PLATFORM_PATH)/eeprom_write_behind.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_write_behind_tests.cpp
@@ -0,0 +1,38 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+/*
+    High resolution timestamps, intended for measuring short durations such as
+    the execution time of a single task. The tick rate is platform dependent and
+    is given by TIMESTAMP_FREQUENCY, in ticks per second.
+
+    Timestamps are free-running and wrap, so always use TIMESTAMP_DIFF() to
+    compute elapsed ticks.
+*/
+
+typedef uint32_t timestamp_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if __has_include_next("_timestamp.h")
+#    include_next "_timestamp.h" /* Include the platform's _timestamp.h */
+#else
+#    include "timer.h"
+// Fall back to the millisecond timer on platforms without a finer counter
+#    define TIMESTAMP_FREQUENCY 1000
+static inline timestamp_t timestamp_read(void) {
+    return timer_read32();
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#define TIMESTAMP_DIFF(a, b) ((timestamp_t)((a) - (b)))
+#define TIMESTAMP_TO_US(t) ((uint32_t)(((uint64_t)(t)*1000000) / (TIMESTAMP_FREQUENCY)))
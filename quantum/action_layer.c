@@ -1,11 +1,13 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
 #include "encoder.h"
 #include "util.h"
 #include "action_layer.h"
+#include "keymap_common.h"
 
 /** \brief Default Layer State
  */
@@ -302,52 +304,132 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
         return layer_switch_get_action(key);
     }
 
-    uint8_t layer;
-
     if (pressed) {
-        layer = layer_switch_get_layer(key);
+        uint16_t keycode;
+        uint8_t  layer = layer_switch_resolve(key, &keycode);
         update_source_layers_cache(key, layer);
-    } else {
-        layer = read_source_layers_cache(key);
+        return action_for_keycode(keycode);
     }
-    return action_for_key(layer, key);
+    return action_for_key(read_source_layers_cache(key), key);
 #else
     return layer_switch_get_action(key);
 #endif
 }
 
-/** \brief Layer switch get layer
+#if defined(LAYER_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+#    define LAYER_LOOKUP_CACHE_EMPTY UINT8_MAX
+#    define LAYER_LOOKUP_CACHE_NONE UINT16_MAX
+
+/** \brief layer lookup cache
  *
- * Gets the layer based on key info
+ * The layer and keycode each matrix key resolves to, valid for the combined
+ * layer state they were resolved under. Any change of layer_state or
+ * default_layer_state empties the cache on the next lookup.
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
+static uint8_t       layer_lookup_cache_layers[MATRIX_ROWS * MATRIX_COLS];
+static uint16_t      layer_lookup_cache_keycodes[MATRIX_ROWS * MATRIX_COLS];
+static layer_state_t layer_lookup_cache_state;
+static bool          layer_lookup_cache_valid = false;
 
+/** \brief layer lookup cache invalidate
+ *
+ * Empties the cache, for when the keymap itself changes.
+ */
+void layer_lookup_cache_invalidate(void) {
+    layer_lookup_cache_valid = false;
+}
+
+/** \brief layer lookup cache entry
+ *
+ * Returns the cache entry of a matrix key, or LAYER_LOOKUP_CACHE_NONE for other keys.
+ */
+static uint16_t layer_lookup_cache_entry(keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return LAYER_LOOKUP_CACHE_NONE;
+    }
+
+    const layer_state_t layers = layer_state | default_layer_state;
+    if (!layer_lookup_cache_valid || layer_lookup_cache_state != layers) {
+        memset(layer_lookup_cache_layers, LAYER_LOOKUP_CACHE_EMPTY, sizeof(layer_lookup_cache_layers));
+        layer_lookup_cache_state = layers;
+        layer_lookup_cache_valid = true;
+    }
+    return (uint16_t)(key.row * MATRIX_COLS) + key.col;
+}
+#endif
+
+/** \brief Layer switch find layer
+ *
+ * Walks the active layers, returning the topmost one that is not transparent
+ * for the key along with the keycode found there
+ */
+static uint8_t layer_switch_find_layer(keypos_t key, uint16_t *keycode) {
+#ifndef NO_ACTION_LAYER
     layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
+            *keycode = keymap_key_to_keycode(i, key);
+            if (action_for_keycode(*keycode).code != ACTION_TRANSPARENT) {
                 return i;
             }
         }
     }
     /* fall back to layer 0 */
+    *keycode = keymap_key_to_keycode(0, key);
     return 0;
 #else
-    return get_highest_layer(default_layer_state);
+    uint8_t layer = get_highest_layer(default_layer_state);
+    *keycode      = keymap_key_to_keycode(layer, key);
+    return layer;
+#endif
+}
+
+/** \brief Layer switch resolve
+ *
+ * Gets the layer and keycode of a key, from the lookup cache where possible
+ */
+uint8_t layer_switch_resolve(keypos_t key, uint16_t *keycode) {
+#if defined(LAYER_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+    const uint16_t entry = layer_lookup_cache_entry(key);
+    if (entry == LAYER_LOOKUP_CACHE_NONE) {
+        return layer_switch_find_layer(key, keycode);
+    }
+    if (layer_lookup_cache_layers[entry] == LAYER_LOOKUP_CACHE_EMPTY) {
+        layer_lookup_cache_layers[entry] = layer_switch_find_layer(key, &layer_lookup_cache_keycodes[entry]);
+    }
+    *keycode = layer_lookup_cache_keycodes[entry];
+    return layer_lookup_cache_layers[entry];
+#else
+    return layer_switch_find_layer(key, keycode);
 #endif
 }
 
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+    uint16_t keycode;
+    return layer_switch_resolve(key, &keycode);
+}
+
+/** \brief Layer switch get keycode
+ *
+ * Gets the keycode of the topmost non-transparent layer for the key
+ */
+uint16_t layer_switch_get_keycode(keypos_t key) {
+    uint16_t keycode;
+    layer_switch_resolve(key, &keycode);
+    return keycode;
+}
+
 /** \brief Layer switch get layer
  *
  * Gets action code based on key position
  */
 action_t layer_switch_get_action(keypos_t key) {
-    return action_for_key(layer_switch_get_layer(key), key);
+    return action_for_keycode(layer_switch_get_keycode(key));
 }
 
 #ifndef NO_ACTION_LAYER
@@ -166,5 +166,16 @@ action_t store_or_get_action(bool pressed, keypos_t key);
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
+/* return the keycode on the topmost non-transparent layer currently associated with key */
+uint16_t layer_switch_get_keycode(keypos_t key);
+
+/* return both the topmost non-transparent layer and its keycode */
+uint8_t layer_switch_resolve(keypos_t key, uint16_t *keycode);
+
+#if defined(LAYER_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+/* forget resolved layers and keycodes, call after changing the keymap at runtime */
+void layer_lookup_cache_invalidate(void);
+#endif
+
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
@@ -1,10 +1,12 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
 #ifndef NO_ACTION_TAPPING
@@ -59,11 +61,23 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
+#    if (WAITING_BUFFER_SIZE & (WAITING_BUFFER_SIZE - 1)) != 0 || WAITING_BUFFER_SIZE > 128
+#        error "WAITING_BUFFER_SIZE must be a power of two, no larger than 128"
+#    endif
+
+// head and tail count up freely, only the low bits index the buffer
+#    define WAITING_BUFFER_INDEX(i) ((uint8_t)(i) & (WAITING_BUFFER_SIZE - 1))
+
 static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+// Matrix keys with a press/release somewhere in the waiting buffer. Bits are
+// only cleared once the buffer empties, so a set bit still needs confirming.
+static matrix_row_t waiting_buffer_pressed_keys[MATRIX_ROWS];
+static matrix_row_t waiting_buffer_released_keys[MATRIX_ROWS];
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
 static void waiting_buffer_clear(void);
@@ -98,15 +112,19 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
-            debug_record(waiting_buffer[waiting_buffer_tail]);
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail++) {
+        if (process_tapping(&waiting_buffer[WAITING_BUFFER_INDEX(waiting_buffer_tail)])) {
+            ac_dprintf("processed: waiting_buffer[%u] =", WAITING_BUFFER_INDEX(waiting_buffer_tail));
+            debug_record(waiting_buffer[WAITING_BUFFER_INDEX(waiting_buffer_tail)]);
             ac_dprintf("\n\n");
         } else {
             break;
         }
     }
+    // rewind once drained, which also resets the key index
+    if (waiting_buffer_tail == waiting_buffer_head && waiting_buffer_head != 0) {
+        waiting_buffer_clear();
+    }
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     }
@@ -432,22 +450,47 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+/** \brief Waiting buffer key index
+ *
+ * Returns the index bitmap for an event's key, or NULL if it is not a matrix key.
+ */
+static inline matrix_row_t *waiting_buffer_key_index(keyevent_t event) {
+    if (event.key.row >= MATRIX_ROWS || event.key.col >= MATRIX_COLS) {
+        return NULL;
+    }
+    return event.pressed ? &waiting_buffer_pressed_keys[event.key.row] : &waiting_buffer_released_keys[event.key.row];
+}
+
+/** \brief Waiting buffer may contain
+ *
+ * Quick check before scanning the buffer for an event of the given key and state.
+ */
+static inline bool waiting_buffer_may_contain(keyevent_t event) {
+    const matrix_row_t *index = waiting_buffer_key_index(event);
+    return index == NULL || (*index & ((matrix_row_t)1 << event.key.col));
+}
+
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Appends a record to the waiting buffer, returning false if it is full.
  */
 bool waiting_buffer_enq(keyrecord_t record) {
     if (IS_NOEVENT(record.event)) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if ((uint8_t)(waiting_buffer_head - waiting_buffer_tail) == WAITING_BUFFER_SIZE) {
         ac_dprintf("waiting_buffer_enq: Over flow.\n");
         return false;
     }
 
-    waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer[WAITING_BUFFER_INDEX(waiting_buffer_head)] = record;
+    waiting_buffer_head++;
+
+    matrix_row_t *index = waiting_buffer_key_index(record.event);
+    if (index) {
+        *index |= (matrix_row_t)1 << record.event.key.col;
+    }
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
@@ -456,20 +499,28 @@ bool waiting_buffer_enq(keyrecord_t record) {
 
 /** \brief Waiting buffer clear
  *
- * FIXME: Needs docs
+ * Empties the waiting buffer and its key index.
  */
 void waiting_buffer_clear(void) {
     waiting_buffer_head = 0;
     waiting_buffer_tail = 0;
+    memset(waiting_buffer_pressed_keys, 0, sizeof(waiting_buffer_pressed_keys));
+    memset(waiting_buffer_released_keys, 0, sizeof(waiting_buffer_released_keys));
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Returns true if the waiting buffer holds the opposite event for the same key,
+ * i.e. the key was pressed and released while the tapping key was undecided.
  */
 bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
+    const keyevent_t opposite = {.key = event.key, .pressed = !event.pressed};
+    if (!waiting_buffer_may_contain(opposite)) {
+        return false;
+    }
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        const keyrecord_t *record = &waiting_buffer[WAITING_BUFFER_INDEX(i)];
+        if (KEYEQ(event.key, record->event.key) && event.pressed != record->event.pressed) {
             return true;
         }
     }
@@ -481,8 +532,8 @@ bool waiting_buffer_typed(keyevent_t event) {
  * FIXME: Needs docs
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        if (waiting_buffer[WAITING_BUFFER_INDEX(i)].event.pressed) return true;
     }
     return false;
 }
@@ -495,25 +546,26 @@ void waiting_buffer_scan_tap(void) {
     // early return if:
     // - tapping already is settled
     // - invalid state: tapping_key released && tap.count == 0
-    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed) {
+    // - the tapping key has not been released since
+    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed || !waiting_buffer_may_contain((keyevent_t){.key = tapping_key.event.key, .pressed = false})) {
         return;
     }
 
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        keyrecord_t *candidate = &waiting_buffer[i];
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        keyrecord_t *candidate = &waiting_buffer[WAITING_BUFFER_INDEX(i)];
         // clang-format off
         if (IS_EVENT(candidate->event) && KEYEQ(candidate->event.key, tapping_key.event.key) && !candidate->event.pressed && (
-            WITHIN_TAPPING_TERM(waiting_buffer[i].event) || MAYBE_RETRO_SHIFTING(waiting_buffer[i].event, &tapping_key)
+            WITHIN_TAPPING_TERM(candidate->event) || MAYBE_RETRO_SHIFTING(candidate->event, &tapping_key)
         )) {
             // clang-format on
             tapping_key.tap.count = 1;
             candidate->tap.count  = 1;
             process_record(&tapping_key);
 
-            ac_dprintf("waiting_buffer_scan_tap: found at [%u]\n", i);
+            ac_dprintf("waiting_buffer_scan_tap: found at [%u]\n", WAITING_BUFFER_INDEX(i));
             debug_waiting_buffer();
             return;
         }
@@ -536,9 +588,9 @@ static void debug_tapping_key(void) {
  */
 static void debug_waiting_buffer(void) {
     ac_dprintf("{ ");
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        ac_dprintf("[%u]=", i);
-        debug_record(waiting_buffer[i]);
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        ac_dprintf("[%u]=", WAITING_BUFFER_INDEX(i));
+        debug_record(waiting_buffer[WAITING_BUFFER_INDEX(i)]);
         ac_dprintf(" ");
     }
     ac_dprintf("}\n");
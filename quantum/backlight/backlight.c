@@ -17,6 +17,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "backlight.h"
 #include "eeprom.h"
+#include "eeprom_write_behind.h"
 #include "eeconfig.h"
 #include "debug.h"
 
@@ -177,11 +178,11 @@ void backlight_level(uint8_t level) {
 }
 
 uint8_t eeconfig_read_backlight(void) {
-    return eeprom_read_byte(EECONFIG_BACKLIGHT);
+    return eeprom_write_behind_read_byte(EECONFIG_BACKLIGHT);
 }
 
 void eeconfig_update_backlight(uint8_t val) {
-    eeprom_update_byte(EECONFIG_BACKLIGHT, val);
+    eeprom_write_behind_update_byte(EECONFIG_BACKLIGHT, val);
 }
 
 void eeconfig_update_backlight_current(void) {
@@ -19,17 +19,14 @@
         PROFILE_CALL_NAMED(1000, "matrix_task", {
             matrix_task();
         });
+
+    For per-task statistics across the whole main loop, see the profiler
+    feature (PROFILER_ENABLE) in profiler.h instead.
 */
 
-#if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
-#    define TIMESTAMP_GETTER TCNT0
-#elif defined(PROTOCOL_CHIBIOS)
-#    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
-#elif defined(PROTOCOL_ARM_ATSAM)
-#    error arm_atsam not currently supported
-#else
-#    error Unknown protocol in use
-#endif
+#include "timestamp.h"
+
+#define TIMESTAMP_GETTER timestamp_read()
 
 #ifndef CONSOLE_ENABLE
 // Can't do anything if we don't have console output enabled.
@@ -39,12 +36,12 @@
 #else
 #    define PROFILE_CALL_NAMED(count, name, call)                                                                         \
         do {                                                                                                              \
-            static uint64_t inner_sum = 0;                                                                                \
-            static uint64_t outer_sum = 0;                                                                                \
-            uint32_t        start_ts;                                                                                     \
-            static uint32_t end_ts;                                                                                       \
-            static uint32_t write_location = 0;                                                                           \
-            start_ts                       = TIMESTAMP_GETTER;                                                            \
+            static uint64_t    inner_sum = 0;                                                                             \
+            static uint64_t    outer_sum = 0;                                                                             \
+            timestamp_t        start_ts;                                                                                  \
+            static timestamp_t end_ts;                                                                                    \
+            static uint32_t    write_location = 0;                                                                        \
+            start_ts                          = TIMESTAMP_GETTER;                                                         \
             if (write_location > 0) {                                                                                     \
                 outer_sum += start_ts - end_ts;                                                                           \
             }                                                                                                             \
@@ -238,6 +238,10 @@ static void print_status(void) {
         , timer_read32()
 
     ); /* clang-format on */
+
+#ifdef PROCESS_RECORD_PROFILER_ENABLE
+    process_record_profiler_print();
+#endif
 }
 
 #if !defined(NO_PRINT) && !defined(USER_PRINT)
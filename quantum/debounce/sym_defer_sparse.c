@@ -0,0 +1,155 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Symmetric per-key algorithm for large matrices. Behaves like sym_defer_pk, but
+instead of a counter for every key it keeps a short list of the keys that are
+currently debouncing. Scans with no raw changes only walk that list, and
+scans with changes only look at the columns of rows that differ from the
+debounced state, so the cost follows the number of keys in motion rather than
+the size of the matrix.
+
+If more than DEBOUNCE_SPARSE_KEYS keys change at once, the extra keys start
+debouncing as soon as a slot becomes free.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#ifndef DEBOUNCE_SPARSE_KEYS
+#    define DEBOUNCE_SPARSE_KEYS 16
+#endif
+
+// The number of keys in motion is kept in a uint8_t
+#if DEBOUNCE_SPARSE_KEYS > UINT8_MAX
+#    error DEBOUNCE_SPARSE_KEYS must not exceed 255
+#endif
+
+#define ROW_SHIFTER ((matrix_row_t)1)
+
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+    uint8_t remaining; // milliseconds
+} debounce_entry_t;
+
+#if DEBOUNCE > 0
+static debounce_entry_t debounce_entries[DEBOUNCE_SPARSE_KEYS];
+static uint8_t          debounce_entry_count;
+static fast_timer_t     last_time;
+static bool             entries_overflowed;
+static bool             cooked_changed;
+
+static void update_debounce_entries_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time);
+static void start_debounce_entries(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+void debounce_init(uint8_t num_rows) {
+    debounce_entry_count = 0;
+    entries_overflowed   = false;
+}
+
+void debounce_free(void) {
+    debounce_entry_count = 0;
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (debounce_entry_count > 0) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_entries_and_transfer_if_expired(raw, cooked, elapsed_time);
+        }
+    }
+
+    if (changed || entries_overflowed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_entries(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static inline void remove_debounce_entry(uint8_t index) {
+    debounce_entries[index] = debounce_entries[--debounce_entry_count];
+}
+
+static void update_debounce_entries_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time) {
+    for (uint8_t i = 0; i < debounce_entry_count;) {
+        debounce_entry_t *entry = &debounce_entries[i];
+        if (entry->remaining <= elapsed_time) {
+            matrix_row_t mask        = ROW_SHIFTER << entry->col;
+            matrix_row_t cooked_next = (cooked[entry->row] & ~mask) | (raw[entry->row] & mask);
+            cooked_changed |= cooked[entry->row] ^ cooked_next;
+            cooked[entry->row] = cooked_next;
+            remove_debounce_entry(i);
+        } else {
+            entry->remaining -= elapsed_time;
+            i++;
+        }
+    }
+}
+
+static void start_debounce_entries(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    entries_overflowed = false;
+
+    // Keys that have bounced back to their debounced state stop counting
+    for (uint8_t i = 0; i < debounce_entry_count;) {
+        debounce_entry_t *entry = &debounce_entries[i];
+        if (!((raw[entry->row] ^ cooked[entry->row]) & (ROW_SHIFTER << entry->col))) {
+            remove_debounce_entry(i);
+        } else {
+            i++;
+        }
+    }
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+        if (!delta) {
+            continue;
+        }
+
+        for (uint8_t i = 0; i < debounce_entry_count; i++) {
+            if (debounce_entries[i].row == row) {
+                delta &= ~(ROW_SHIFTER << debounce_entries[i].col);
+            }
+        }
+
+        while (delta) {
+            if (debounce_entry_count == DEBOUNCE_SPARSE_KEYS) {
+                entries_overflowed = true;
+                return;
+            }
+            uint8_t col = __builtin_ctzl(delta);
+            delta &= delta - 1;
+
+            debounce_entries[debounce_entry_count++] = (debounce_entry_t){.row = row, .col = col, .remaining = DEBOUNCE};
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,168 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Symmetric per-key algorithm using vertical counters. Behaves like sym_defer_pk,
+but the counters are stored as bit-planes per row: bit n of plane p is bit p of
+the counter of column n. Counting down and expiry are then done for a whole row
+at a time with a few bitwise operations, and each key only needs as many bits
+as it takes to hold DEBOUNCE.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <stdlib.h>
+
+#ifdef PROTOCOL_CHIBIOS
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
+#    endif
+#endif
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE < 2
+#    define DEBOUNCE_PLANES 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_PLANES 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_PLANES 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_PLANES 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_PLANES 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_PLANES 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_PLANES 7
+#else
+#    define DEBOUNCE_PLANES 8
+#endif
+
+#if DEBOUNCE > 0
+// [row][plane]
+static matrix_row_t *debounce_planes;
+static fast_timer_t  last_time;
+static bool          counters_need_update;
+static bool          cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_planes = (matrix_row_t *)calloc(num_rows * DEBOUNCE_PLANES, sizeof(matrix_row_t));
+}
+
+void debounce_free(void) {
+    free(debounce_planes);
+    debounce_planes = NULL;
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        // No counter holds more than DEBOUNCE, so this expires the same keys
+        // while keeping elapsed_time within the width of the counters
+        if (elapsed_time > DEBOUNCE) {
+            elapsed_time = DEBOUNCE;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_row_t *planes = debounce_planes;
+    for (uint8_t row = 0; row < num_rows; row++, planes += DEBOUNCE_PLANES) {
+        matrix_row_t active = 0;
+        for (uint8_t p = 0; p < DEBOUNCE_PLANES; p++) {
+            active |= planes[p];
+        }
+        if (!active) {
+            continue;
+        }
+
+        // Subtract elapsed_time from every counter of the row at once. A
+        // borrow out of the top plane means the counter was below it.
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t p = 0; p < DEBOUNCE_PLANES; p++) {
+            const matrix_row_t subtrahend = (elapsed_time >> p) & 1 ? ~(matrix_row_t)0 : 0;
+            const matrix_row_t counter    = planes[p];
+            const matrix_row_t difference = counter ^ subtrahend ^ borrow;
+
+            borrow    = (~counter & (subtrahend | borrow)) | (subtrahend & borrow);
+            planes[p] = difference;
+            remaining |= difference;
+        }
+
+        const matrix_row_t expired = active & (borrow | ~remaining);
+        for (uint8_t p = 0; p < DEBOUNCE_PLANES; p++) {
+            planes[p] &= active & ~expired;
+        }
+        if (active & ~expired) {
+            counters_need_update = true;
+        }
+
+        matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+        cooked_changed |= cooked[row] ^ cooked_next;
+        cooked[row] = cooked_next;
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_row_t *planes = debounce_planes;
+    for (uint8_t row = 0; row < num_rows; row++, planes += DEBOUNCE_PLANES) {
+        const matrix_row_t delta  = raw[row] ^ cooked[row];
+        matrix_row_t       active = 0;
+        for (uint8_t p = 0; p < DEBOUNCE_PLANES; p++) {
+            active |= planes[p];
+        }
+
+        // Keys that changed start counting down from DEBOUNCE, unless they
+        // already are. Keys back to their debounced state stop counting.
+        const matrix_row_t start = delta & ~active;
+        for (uint8_t p = 0; p < DEBOUNCE_PLANES; p++) {
+            if ((DEBOUNCE >> p) & 1) {
+                planes[p] |= start;
+            }
+            planes[p] &= delta;
+        }
+        if (delta) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "debounce_benchmark.h"
+
+#define debounce_init none_debounce_init
+#define debounce none_debounce
+#define debounce_free none_debounce_free
+#define debounce_active none_debounce_active
+
+#include "../../none.c"
+
+const size_t none_debounce_static_bytes = 0;
@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "debounce_benchmark.h"
+
+#define debounce_init sym_eager_pk_debounce_init
+#define debounce sym_eager_pk_debounce
+#define debounce_free sym_eager_pk_debounce_free
+#define debounce_active sym_eager_pk_debounce_active
+
+#include "../../sym_eager_pk.c"
+
+const size_t sym_eager_pk_debounce_static_bytes = sizeof(debounce_counters) + sizeof(last_time) + sizeof(counters_need_update) + sizeof(matrix_need_update) + sizeof(cooked_changed);
@@ -0,0 +1,220 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "debounce_benchmark.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+}
+
+size_t debounce_benchmark_heap_used = 0;
+
+extern "C" void *debounce_benchmark_malloc(size_t size) {
+    debounce_benchmark_heap_used += size;
+    return malloc(size);
+}
+
+extern "C" void *debounce_benchmark_calloc(size_t count, size_t size) {
+    debounce_benchmark_heap_used += count * size;
+    return calloc(count, size);
+}
+
+namespace {
+
+// Scans per millisecond, i.e. a 4kHz scan rate
+constexpr uint32_t SCANS_PER_MS = 4;
+// Trace length, the last part of which is left quiet so everything settles
+constexpr uint32_t TRACE_MS = 5000;
+constexpr uint32_t QUIET_MS = 100;
+// Chance of a new key transition starting each millisecond
+constexpr double TRANSITION_RATE = 0.05;
+// A key is left alone for this long after each transition
+constexpr uint32_t KEY_COOLDOWN_MS = 40;
+
+struct RawEdge {
+    uint32_t scan;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+struct Transition {
+    uint32_t scan;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+struct Trace {
+    std::vector<RawEdge>    edges;
+    std::vector<Transition> transitions;
+};
+
+// Key presses and releases, each with up to three bounces of 1-3 scans
+Trace generate_trace(uint32_t seed) {
+    Trace                                   trace;
+    std::mt19937                            rng(seed);
+    std::uniform_real_distribution<double>  chance(0, 1);
+    std::uniform_int_distribution<uint32_t> key_dist(0, MATRIX_ROWS * MATRIX_COLS - 1);
+    std::uniform_int_distribution<uint32_t> bounce_count(0, 3);
+    std::uniform_int_distribution<uint32_t> bounce_gap(1, 3);
+
+    std::vector<bool>     key_state(MATRIX_ROWS * MATRIX_COLS, false);
+    std::vector<uint32_t> key_busy_until(MATRIX_ROWS * MATRIX_COLS, 0);
+
+    for (uint32_t ms = 0; ms < TRACE_MS - QUIET_MS; ms++) {
+        if (chance(rng) >= TRANSITION_RATE) {
+            continue;
+        }
+        uint32_t key = key_dist(rng);
+        if (key_busy_until[key] > ms) {
+            continue;
+        }
+        key_busy_until[key] = ms + KEY_COOLDOWN_MS;
+
+        const uint8_t row     = key / MATRIX_COLS;
+        const uint8_t col     = key % MATRIX_COLS;
+        const bool    pressed = !key_state[key];
+        key_state[key]        = pressed;
+
+        uint32_t scan = ms * SCANS_PER_MS;
+        trace.transitions.push_back({scan, row, col, pressed});
+        trace.edges.push_back({scan, row, col, pressed});
+        for (uint32_t bounces = bounce_count(rng); bounces > 0; bounces--) {
+            scan += bounce_gap(rng);
+            trace.edges.push_back({scan, row, col, !pressed});
+            scan += bounce_gap(rng);
+            trace.edges.push_back({scan, row, col, pressed});
+        }
+    }
+
+    std::stable_sort(trace.edges.begin(), trace.edges.end(), [](const RawEdge &a, const RawEdge &b) { return a.scan < b.scan; });
+    return trace;
+}
+
+struct Algorithm {
+    const char *name;
+    void (*init)(uint8_t num_rows);
+    bool (*debounce)(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+    void (*free)(void);
+    const size_t *static_bytes;
+};
+
+#define DEBOUNCE_BENCHMARK_ENTRY(name) {#name, name##_debounce_init, name##_debounce, name##_debounce_free, &name##_debounce_static_bytes},
+
+const Algorithm algorithms[] = {DEBOUNCE_BENCHMARK_ALGORITHMS(DEBOUNCE_BENCHMARK_ENTRY)};
+
+struct Result {
+    double   ns_per_call;
+    size_t   ram_bytes; // static variables plus heap
+    double   mean_latency_ms;
+    double   max_latency_ms;
+    uint32_t spurious;
+    bool     settled;
+};
+
+Result run(const Algorithm &algorithm, const Trace &trace) {
+    Result result = {};
+
+    matrix_row_t raw[MATRIX_ROWS]    = {0};
+    matrix_row_t cooked[MATRIX_ROWS] = {0};
+
+    // Scan at which each key's pending transition started, or UINT32_MAX
+    std::vector<uint32_t> pending(MATRIX_ROWS * MATRIX_COLS, UINT32_MAX);
+    auto                  next_transition = trace.transitions.begin();
+    auto                  next_edge       = trace.edges.begin();
+
+    uint64_t latency_total   = 0;
+    uint32_t latency_count   = 0;
+    uint32_t latency_max     = 0;
+    uint32_t cooked_changes  = 0;
+    uint64_t debounce_ns     = 0;
+    uint32_t debounce_calls  = 0;
+    uint32_t transitions_run = 0;
+
+    set_time(0);
+    debounce_benchmark_heap_used = 0;
+    algorithm.init(MATRIX_ROWS);
+    result.ram_bytes = *algorithm.static_bytes + debounce_benchmark_heap_used;
+
+    for (uint32_t scan = 0; scan < TRACE_MS * SCANS_PER_MS; scan++) {
+        set_time(scan / SCANS_PER_MS);
+
+        for (; next_transition != trace.transitions.end() && next_transition->scan == scan; next_transition++) {
+            pending[next_transition->row * MATRIX_COLS + next_transition->col] = scan;
+            transitions_run++;
+        }
+
+        bool changed = false;
+        for (; next_edge != trace.edges.end() && next_edge->scan == scan; next_edge++) {
+            const matrix_row_t bit  = MATRIX_ROW_SHIFTER << next_edge->col;
+            const matrix_row_t prev = raw[next_edge->row];
+            raw[next_edge->row]     = next_edge->pressed ? (prev | bit) : (prev & ~bit);
+            changed |= raw[next_edge->row] != prev;
+        }
+
+        matrix_row_t previous[MATRIX_ROWS];
+        std::copy(cooked, cooked + MATRIX_ROWS, previous);
+
+        const auto start = std::chrono::steady_clock::now();
+        algorithm.debounce(raw, cooked, MATRIX_ROWS, changed);
+        const auto end = std::chrono::steady_clock::now();
+        debounce_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        debounce_calls++;
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            const matrix_row_t delta = previous[row] ^ cooked[row];
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (!(delta & (MATRIX_ROW_SHIFTER << col))) {
+                    continue;
+                }
+                cooked_changes++;
+                uint32_t &started = pending[row * MATRIX_COLS + col];
+                if (started != UINT32_MAX) {
+                    const uint32_t latency = scan - started;
+                    latency_total += latency;
+                    latency_max = std::max(latency_max, latency);
+                    latency_count++;
+                    started = UINT32_MAX;
+                }
+            }
+        }
+    }
+
+    algorithm.free();
+
+    result.ns_per_call     = debounce_calls ? (double)debounce_ns / debounce_calls : 0;
+    result.mean_latency_ms = latency_count ? (double)latency_total / latency_count / SCANS_PER_MS : 0;
+    result.max_latency_ms  = (double)latency_max / SCANS_PER_MS;
+    result.spurious        = cooked_changes > transitions_run ? cooked_changes - transitions_run : 0;
+    result.settled         = std::equal(raw, raw + MATRIX_ROWS, cooked) && latency_count == transitions_run;
+    return result;
+}
+
+} // namespace
+
+TEST(DebounceBenchmark, AllAlgorithms) {
+    const Trace trace = generate_trace(0x514B);
+
+    printf("%ux%u matrix, DEBOUNCE=%u, %zu transitions, %zu raw edges, %u scans/ms\n", MATRIX_ROWS, MATRIX_COLS, DEBOUNCE, trace.transitions.size(), trace.edges.size(), SCANS_PER_MS);
+    printf("%-20s %10s %10s %12s %12s %9s\n", "algorithm", "ns/call", "RAM (B)", "latency avg", "latency max", "spurious");
+    for (const Algorithm &algorithm : algorithms) {
+        const Result result = run(algorithm, trace);
+        printf("%-20s %10.1f %10zu %10.2fms %10.2fms %9u\n", algorithm.name, result.ns_per_call, result.ram_bytes, result.mean_latency_ms, result.max_latency_ms, result.spurious);
+
+        EXPECT_TRUE(result.settled) << algorithm.name << " did not settle to the raw matrix state";
+        if (strcmp(algorithm.name, "none") != 0) {
+            EXPECT_EQ(result.spurious, 0) << algorithm.name << " let bounces through";
+        }
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "matrix.h"
+
+/*
+    Every debounce algorithm is built into the benchmark with its entry points
+    prefixed by its name, and its heap allocations counted. Each wrapper also
+    exports the size of the algorithm's static variables, so that the two
+    add up to the RAM it uses.
+*/
+
+#define DEBOUNCE_BENCHMARK_ALGORITHMS(X) \
+    X(none)                              \
+    X(sym_defer_g)                       \
+    X(sym_defer_pk)                      \
+    X(sym_defer_pr)                      \
+    X(sym_defer_vc)                      \
+    X(sym_defer_sparse)                  \
+    X(sym_eager_pk)                      \
+    X(sym_eager_pr)                      \
+    X(asym_eager_defer_pk)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEBOUNCE_BENCHMARK_DECLARE(name)                                                           \
+    void name##_debounce_init(uint8_t num_rows);                                                   \
+    bool name##_debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed); \
+    void name##_debounce_free(void);                                                               \
+    extern const size_t name##_debounce_static_bytes;
+
+DEBOUNCE_BENCHMARK_ALGORITHMS(DEBOUNCE_BENCHMARK_DECLARE)
+
+extern size_t debounce_benchmark_heap_used;
+
+void *debounce_benchmark_malloc(size_t size);
+void *debounce_benchmark_calloc(size_t count, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifndef __cplusplus
+#    define malloc(size) debounce_benchmark_malloc(size)
+#    define calloc(count, size) debounce_benchmark_calloc(count, size)
+#endif
@@ -38,6 +38,16 @@ debounce_sym_defer_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pr.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_pr_tests.cpp
 
+debounce_sym_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_vc_tests.cpp
+
+debounce_sym_defer_sparse_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_SPARSE_KEYS=4
+debounce_sym_defer_sparse_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_sparse.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_sparse_tests.cpp
+
 debounce_sym_eager_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_eager_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pk.c \
@@ -52,3 +62,29 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+# Benchmarks all algorithms against the same synthetic bounce trace; the
+# matrix size is fixed at compile time so each size is its own target
+DEBOUNCE_BENCHMARK_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_none.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_sym_defer_g.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_sym_defer_pk.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_sym_defer_pr.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_sym_defer_sparse.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_sym_eager_pk.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_sym_eager_pr.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/bench_asym_eager_defer_pk.c \
+	$(QUANTUM_PATH)/debounce/tests/benchmark/debounce_benchmark.cpp
+
+debounce_benchmark_4x12_DEFS := -DMATRIX_ROWS=4 -DMATRIX_COLS=12 -DDEBOUNCE=5
+debounce_benchmark_4x12_SRC := $(DEBOUNCE_BENCHMARK_SRC)
+
+debounce_benchmark_6x16_DEFS := -DMATRIX_ROWS=6 -DMATRIX_COLS=16 -DDEBOUNCE=5
+debounce_benchmark_6x16_SRC := $(DEBOUNCE_BENCHMARK_SRC)
+
+debounce_benchmark_8x24_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=24 -DDEBOUNCE=5
+debounce_benchmark_8x24_SRC := $(DEBOUNCE_BENCHMARK_SRC)
+
+debounce_benchmark_16x32_DEFS := -DMATRIX_ROWS=16 -DMATRIX_COLS=32 -DDEBOUNCE=5
+debounce_benchmark_16x32_SRC := $(DEBOUNCE_BENCHMARK_SRC)
@@ -3,6 +3,12 @@ TEST_LIST += \
 	debounce_sym_defer_g \
 	debounce_sym_defer_pk \
 	debounce_sym_defer_pr \
+	debounce_sym_defer_vc \
+	debounce_sym_defer_sparse \
 	debounce_sym_eager_pk \
 	debounce_sym_eager_pr \
-	debounce_asym_eager_defer_pk
+	debounce_asym_eager_defer_pk \
+	debounce_benchmark_4x12 \
+	debounce_benchmark_6x16 \
+	debounce_benchmark_8x24 \
+	debounce_benchmark_16x32
@@ -21,6 +21,8 @@
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "keyboard.h"
+#include <string.h>
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -63,9 +65,19 @@
 #    error DYNAMIC_KEYMAP_EEPROM_MAX_ADDR must be less than 65536
 #endif
 
+#ifdef DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE
+// The change journal's boot counter comes first
+#    ifndef DYNAMIC_KEYMAP_EPOCH_EEPROM_ADDR
+#        define DYNAMIC_KEYMAP_EPOCH_EEPROM_ADDR DYNAMIC_KEYMAP_EEPROM_START
+#    endif
+#    define DYNAMIC_KEYMAP_EPOCH_EEPROM_SIZE 2
+#else
+#    define DYNAMIC_KEYMAP_EPOCH_EEPROM_SIZE 0
+#endif
+
 // If DYNAMIC_KEYMAP_EEPROM_ADDR not explicitly defined in config.h,
 #ifndef DYNAMIC_KEYMAP_EEPROM_ADDR
-#    define DYNAMIC_KEYMAP_EEPROM_ADDR DYNAMIC_KEYMAP_EEPROM_START
+#    define DYNAMIC_KEYMAP_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_START + DYNAMIC_KEYMAP_EPOCH_EEPROM_SIZE)
 #endif
 
 // Dynamic encoders starts after dynamic keymaps
@@ -101,6 +113,128 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+#    include "timer.h"
+
+#    ifndef DYNAMIC_KEYMAP_WRITE_BACK_DELAY
+#        define DYNAMIC_KEYMAP_WRITE_BACK_DELAY 500
+#    endif
+
+#    define DYNAMIC_KEYMAP_KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+
+// Keycodes of all layers, in the same order as in EEPROM
+static uint16_t dynamic_keymap_mirror[DYNAMIC_KEYMAP_KEY_COUNT];
+static bool     dynamic_keymap_mirror_loaded = false;
+
+// Keys changed since the last write back to EEPROM
+static uint8_t  dynamic_keymap_dirty[(DYNAMIC_KEYMAP_KEY_COUNT + 7) / 8];
+static bool     dynamic_keymap_has_dirty   = false;
+static uint16_t dynamic_keymap_last_change = 0;
+
+void dynamic_keymap_mirror_load(void) {
+    uint8_t *bytes = (uint8_t *)dynamic_keymap_mirror;
+    eeprom_read_block(bytes, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_mirror));
+    // Big endian in EEPROM
+    for (uint16_t i = 0; i < DYNAMIC_KEYMAP_KEY_COUNT; i++) {
+        dynamic_keymap_mirror[i] = (bytes[i * 2] << 8) | bytes[i * 2 + 1];
+    }
+
+    memset(dynamic_keymap_dirty, 0, sizeof(dynamic_keymap_dirty));
+    dynamic_keymap_has_dirty     = false;
+    dynamic_keymap_mirror_loaded = true;
+}
+
+static uint16_t *dynamic_keymap_mirror_key(uint16_t index) {
+    if (!dynamic_keymap_mirror_loaded) {
+        dynamic_keymap_mirror_load();
+    }
+    return &dynamic_keymap_mirror[index];
+}
+
+static void dynamic_keymap_mirror_set(uint16_t index, uint16_t keycode) {
+    uint16_t *key = dynamic_keymap_mirror_key(index);
+    if (*key != keycode) {
+        *key = keycode;
+        dynamic_keymap_dirty[index / 8] |= 1 << (index % 8);
+        dynamic_keymap_has_dirty = true;
+    }
+    dynamic_keymap_last_change = timer_read();
+}
+
+static bool dynamic_keymap_is_dirty(uint16_t index) {
+    return dynamic_keymap_dirty[index / 8] & (1 << (index % 8));
+}
+
+void dynamic_keymap_flush(void) {
+    if (!dynamic_keymap_has_dirty) {
+        return;
+    }
+
+    // Changed keys next to each other are written back as one block
+    uint8_t  block[32];
+    uint16_t index = 0;
+    while (index < DYNAMIC_KEYMAP_KEY_COUNT) {
+        if (!dynamic_keymap_is_dirty(index)) {
+            index++;
+            continue;
+        }
+
+        uint16_t start  = index;
+        uint8_t  length = 0;
+        while (index < DYNAMIC_KEYMAP_KEY_COUNT && dynamic_keymap_is_dirty(index) && length < sizeof(block)) {
+            block[length++] = dynamic_keymap_mirror[index] >> 8;
+            block[length++] = dynamic_keymap_mirror[index] & 0xFF;
+            dynamic_keymap_dirty[index / 8] &= ~(1 << (index % 8));
+            index++;
+        }
+        eeprom_update_block(block, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + start * 2), length);
+    }
+    dynamic_keymap_has_dirty = false;
+}
+
+void dynamic_keymap_task(void) {
+    if (dynamic_keymap_has_dirty && timer_elapsed(dynamic_keymap_last_change) >= DYNAMIC_KEYMAP_WRITE_BACK_DELAY) {
+        dynamic_keymap_flush();
+    }
+}
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
+#ifdef DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE
+_Static_assert((DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE & (DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE - 1)) == 0 && DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE <= 256, "DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE must be a power of two, no larger than 256");
+
+// Index of the key changed by each of the most recent generations, so
+// the generation counter can wrap around without breaking the lookup
+static uint16_t dynamic_keymap_journal[DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE];
+static uint16_t dynamic_keymap_generation = 0;
+static uint16_t dynamic_keymap_epoch      = 0;
+static bool     dynamic_keymap_epoch_set  = false;
+
+static void dynamic_keymap_journal_change(uint16_t index) {
+    // Starts this power-up's epoch before its first generation goes by
+    dynamic_keymap_get_epoch();
+    dynamic_keymap_journal[dynamic_keymap_generation % DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE] = index;
+    dynamic_keymap_generation++;
+}
+
+uint16_t dynamic_keymap_get_epoch(void) {
+    // Counted in EEPROM, once per power-up and only if the journal is used
+    if (!dynamic_keymap_epoch_set) {
+        dynamic_keymap_epoch = eeprom_read_word((uint16_t *)(uintptr_t)(DYNAMIC_KEYMAP_EPOCH_EEPROM_ADDR)) + 1;
+        eeprom_update_word((uint16_t *)(uintptr_t)(DYNAMIC_KEYMAP_EPOCH_EEPROM_ADDR), dynamic_keymap_epoch);
+        dynamic_keymap_epoch_set = true;
+    }
+    return dynamic_keymap_epoch;
+}
+
+uint16_t dynamic_keymap_get_generation(void) {
+    return dynamic_keymap_generation;
+}
+
+uint16_t dynamic_keymap_get_changed_key(uint16_t generation) {
+    return dynamic_keymap_journal[generation % DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE];
+}
+#endif // DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -112,19 +246,40 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    return *dynamic_keymap_mirror_key((layer * MATRIX_ROWS + row) * MATRIX_COLS + column);
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+#ifdef DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE
+    if (dynamic_keymap_get_keycode(layer, row, column) != keycode) {
+        dynamic_keymap_journal_change((layer * MATRIX_ROWS + row) * MATRIX_COLS + column);
+    }
+#endif
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_mirror_set((layer * MATRIX_ROWS + row) * MATRIX_COLS + column, keycode);
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#endif
+#ifdef MATRIX_HAS_GHOST
+    if (layer == 0) {
+        keyboard_update_real_key(row, column, keycode != KC_NO);
+    }
+#endif
+#if defined(LAYER_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+    layer_lookup_cache_invalidate();
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -165,15 +320,27 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // The EEPROM may just have been erased underneath the mirror, so every
+    // key is written back, not only those that differ from the mirror
+    memset(dynamic_keymap_dirty, 0xFF, sizeof(dynamic_keymap_dirty));
+    dynamic_keymap_has_dirty = true;
+    dynamic_keymap_flush();
+#endif
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+            uint16_t keycode = *dynamic_keymap_mirror_key((offset + i) / 2);
+            *target          = (offset + i) % 2 ? keycode & 0xFF : keycode >> 8;
+#else
             *target = eeprom_read_byte(source);
+#endif
         } else {
             *target = 0x00;
         }
@@ -184,15 +351,44 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
+#ifdef DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE
+    uint16_t last_changed = UINT16_MAX;
+#endif
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE
+            // Both bytes of a keycode count as one change
+            uint8_t current;
+            dynamic_keymap_get_buffer(offset + i, 1, &current);
+            if (current != *source && (offset + i) / 2 != last_changed) {
+                last_changed = (offset + i) / 2;
+                dynamic_keymap_journal_change(last_changed);
+            }
+#endif
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+            uint16_t keycode = *dynamic_keymap_mirror_key((offset + i) / 2);
+            keycode          = (offset + i) % 2 ? (keycode & 0xFF00) | *source : (keycode & 0x00FF) | (*source << 8);
+            dynamic_keymap_mirror_set((offset + i) / 2, keycode);
+#else
             eeprom_update_byte(target, *source);
+#endif
         }
         source++;
         target++;
     }
+#ifdef MATRIX_HAS_GHOST
+    // Only the base layer takes part in ghost detection
+    if (offset < MATRIX_ROWS * MATRIX_COLS * 2) {
+        keyboard_update_real_keys();
+    }
+#endif
+#if defined(LAYER_LOOKUP_CACHE) && !defined(NO_ACTION_LAYER)
+    if (offset < dynamic_keymap_eeprom_size) {
+        layer_lookup_cache_invalidate();
+    }
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,7 +416,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -234,7 +430,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -246,8 +442,8 @@ void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_reset(void) {
-    void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    void *p   = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
+    void *end = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (p != end) {
         eeprom_update_byte(p, 0);
         ++p;
@@ -263,15 +459,15 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // If it's not zero, then we are in the middle
     // of buffer writing, possibly an aborted buffer
     // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
+    void *p = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
     if (eeprom_read_byte(p) != 0) {
         return;
     }
 
     // Skip N null characters
     // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    p         = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
+    void *end = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (id > 0) {
         // If we are past the end of the buffer, then there is
         // no Nth macro in the buffer.
@@ -38,6 +38,29 @@ void dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// With the RAM mirror, the keycodes are read from EEPROM once, on first use,
+// and changes are written back once they've settled for
+// DYNAMIC_KEYMAP_WRITE_BACK_DELAY milliseconds.
+void dynamic_keymap_mirror_load(void);
+void dynamic_keymap_flush(void);
+void dynamic_keymap_task(void);
+#endif
+
+#ifdef DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE
+// Every change to a keycode moves the keymap on by one generation. The keys
+// changed by the last DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE generations are
+// remembered, so a host can fetch only what changed since it last looked.
+// dynamic_keymap_get_changed_key() returns the index of the key whose change
+// moved the keymap on from the given generation; the index is the buffer
+// offset divided by two. The generation starts from zero on every power-up,
+// so it is only meaningful together with the epoch, which is different for
+// every power-up.
+uint16_t dynamic_keymap_get_epoch(void);
+uint16_t dynamic_keymap_get_generation(void);
+uint16_t dynamic_keymap_get_changed_key(uint16_t generation);
+#endif
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdint.h>
 #include <stdbool.h>
 #include "eeprom.h"
+#include "eeprom_write_behind.h"
 
 #ifndef EECONFIG_MAGIC_NUMBER
 #    define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEE6 // When changing, decrement this value to avoid future re-init issues
@@ -148,41 +149,41 @@ void eeconfig_init_user_datablock(void);
 // Any "checked" debounce variant used requires implementation of:
 //    -- bool eeconfig_check_valid_##name(void)
 //    -- void eeconfig_post_flush_##name(void)
-#define EECONFIG_DEBOUNCE_HELPER_CHECKED(name, offset, config)          \
-    static uint8_t dirty_##name = false;                                \
-                                                                        \
-    bool eeconfig_check_valid_##name(void);                             \
-    void eeconfig_post_flush_##name(void);                              \
-                                                                        \
-    static inline void eeconfig_init_##name(void) {                     \
-        dirty_##name = true;                                            \
-        if (eeconfig_check_valid_##name()) {                            \
-            eeprom_read_block(&config, offset, sizeof(config));         \
-            dirty_##name = false;                                       \
-        }                                                               \
-    }                                                                   \
-    static inline void eeconfig_flush_##name(bool force) {              \
-        if (force || dirty_##name) {                                    \
-            eeprom_update_block(&config, offset, sizeof(config));       \
-            eeconfig_post_flush_##name();                               \
-            dirty_##name = false;                                       \
-        }                                                               \
-    }                                                                   \
-    static inline void eeconfig_flush_##name##_task(uint16_t timeout) { \
-        static uint16_t flush_timer = 0;                                \
-        if (timer_elapsed(flush_timer) > timeout) {                     \
-            eeconfig_flush_##name(false);                               \
-            flush_timer = timer_read();                                 \
-        }                                                               \
-    }                                                                   \
-    static inline void eeconfig_flag_##name(bool v) {                   \
-        dirty_##name |= v;                                              \
-    }                                                                   \
-    static inline void eeconfig_write_##name(typeof(config) *conf) {    \
-        if (memcmp(&config, conf, sizeof(config)) != 0) {               \
-            memcpy(&config, conf, sizeof(config));                      \
-            eeconfig_flag_##name(true);                                 \
-        }                                                               \
+#define EECONFIG_DEBOUNCE_HELPER_CHECKED(name, offset, config)                 \
+    static uint8_t dirty_##name = false;                                       \
+                                                                               \
+    bool eeconfig_check_valid_##name(void);                                    \
+    void eeconfig_post_flush_##name(void);                                     \
+                                                                               \
+    static inline void eeconfig_init_##name(void) {                            \
+        dirty_##name = true;                                                   \
+        if (eeconfig_check_valid_##name()) {                                   \
+            eeprom_write_behind_read_block(&config, offset, sizeof(config));   \
+            dirty_##name = false;                                              \
+        }                                                                      \
+    }                                                                          \
+    static inline void eeconfig_flush_##name(bool force) {                     \
+        if (force || dirty_##name) {                                           \
+            eeprom_write_behind_update_block(&config, offset, sizeof(config)); \
+            eeconfig_post_flush_##name();                                      \
+            dirty_##name = false;                                              \
+        }                                                                      \
+    }                                                                          \
+    static inline void eeconfig_flush_##name##_task(uint16_t timeout) {        \
+        static uint16_t flush_timer = 0;                                       \
+        if (timer_elapsed(flush_timer) > timeout) {                            \
+            eeconfig_flush_##name(false);                                      \
+            flush_timer = timer_read();                                        \
+        }                                                                      \
+    }                                                                          \
+    static inline void eeconfig_flag_##name(bool v) {                          \
+        dirty_##name |= v;                                                     \
+    }                                                                          \
+    static inline void eeconfig_write_##name(typeof(config) *conf) {           \
+        if (memcmp(&config, conf, sizeof(config)) != 0) {                      \
+            memcpy(&config, conf, sizeof(config));                             \
+            eeconfig_flag_##name(true);                                        \
+        }                                                                      \
     }
 
 #define EECONFIG_DEBOUNCE_HELPER(name, offset, config)     \
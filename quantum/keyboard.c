@@ -32,6 +32,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "profiler.h"
+#include "latency_trace.h"
+#include "process_record_profiler.h"
+#include "task_scheduler.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -107,9 +111,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+#    include "eeprom_write_behind.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -131,6 +141,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef LEADER_ENABLE
 #    include "leader.h"
 #endif
+#ifdef SEND_STRING_ENABLE
+#    include "send_string.h"
+#endif
 #ifdef UNICODE_COMMON_ENABLE
 #    include "unicode.h"
 #endif
@@ -217,16 +230,39 @@ uint32_t get_matrix_scan_rate(void) {
 #endif
 
 #ifdef MATRIX_HAS_GHOST
-static matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
-    matrix_row_t out = 0;
-    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
-        // read each key in the row data and check if the keymap defines it as a real key
-        if (keycode_at_keymap_location(0, row, col) && (rowdata & (((matrix_row_t)1) << col))) {
-            // this creates new row data, if a key is defined in the keymap, it will be set here
-            out |= ((matrix_row_t)1) << col;
+// Keys defined on the base layer, one bit per column. Looking these up is
+// slow with dynamic keymaps, so they are only read when the keymap changes.
+static matrix_row_t real_keys[MATRIX_ROWS];
+
+/** \brief Rebuild the mask of real keys used by ghost detection
+ *
+ * Must be called whenever the base layer of the keymap changes.
+ */
+void keyboard_update_real_keys(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t mask = 0;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (keycode_at_keymap_location(0, row, col)) {
+                mask |= ((matrix_row_t)1) << col;
+            }
         }
+        real_keys[row] = mask;
+    }
+}
+
+/** \brief Update a single key in the mask of real keys
+ */
+void keyboard_update_real_key(uint8_t row, uint8_t col, bool real) {
+    if (row >= MATRIX_ROWS || col >= MATRIX_COLS) return;
+    if (real) {
+        real_keys[row] |= ((matrix_row_t)1) << col;
+    } else {
+        real_keys[row] &= ~(((matrix_row_t)1) << col);
     }
-    return out;
+}
+
+static inline matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
+    return rowdata & real_keys[row];
 }
 
 static inline bool popcount_more_than_one(matrix_row_t rowdata) {
@@ -419,6 +455,9 @@ void keyboard_init(void) {
 #endif
     matrix_init();
     quantum_init();
+#ifdef MATRIX_HAS_GHOST
+    keyboard_update_real_keys();
+#endif
     led_init_ports();
 #ifdef BACKLIGHT_ENABLE
     backlight_init_ports();
@@ -485,6 +524,9 @@ void keyboard_init(void) {
 #ifdef HAPTIC_ENABLE
     haptic_init();
 #endif
+#ifdef TASK_SCHEDULER_ENABLE
+    task_scheduler_init();
+#endif
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
@@ -507,6 +549,41 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 #endif
 }
 
+#ifndef KEYEVENT_QUEUE_SIZE
+#    define KEYEVENT_QUEUE_SIZE 8
+#endif
+
+_Static_assert(KEYEVENT_QUEUE_SIZE > 0 && KEYEVENT_QUEUE_SIZE <= 255, "KEYEVENT_QUEUE_SIZE must be between 1 and 255");
+
+// Key events of the current scan, waiting to be handed to action_exec()
+static keyevent_t keyevent_queue[KEYEVENT_QUEUE_SIZE];
+static uint8_t    keyevent_queue_head  = 0;
+static uint8_t    keyevent_queue_count = 0;
+
+/**
+ * @brief Processes all queued key events, oldest first.
+ */
+static void keyevent_queue_drain(void) {
+    while (keyevent_queue_count) {
+        const keyevent_t event = keyevent_queue[keyevent_queue_head];
+        keyevent_queue_head    = (keyevent_queue_head + 1) % KEYEVENT_QUEUE_SIZE;
+        keyevent_queue_count--;
+        action_exec(event);
+    }
+}
+
+/**
+ * @brief Queues a key event for processing. Should the queue be full, the
+ * pending events are processed first, so ordering is always preserved.
+ */
+static void keyevent_queue_push(keyevent_t event) {
+    if (keyevent_queue_count == KEYEVENT_QUEUE_SIZE) {
+        keyevent_queue_drain();
+    }
+    keyevent_queue[(keyevent_queue_head + keyevent_queue_count) % KEYEVENT_QUEUE_SIZE] = event;
+    keyevent_queue_count++;
+}
+
 /**
  * @brief Generates a tick event at a maximum rate of 1KHz that drives the
  * internal QMK state machine.
@@ -535,8 +612,12 @@ static bool matrix_task(void) {
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
+    LATENCY_TRACE_SCAN_BEGIN();
     matrix_scan();
-    bool matrix_changed = false;
+    // All events of this scan carry the time it happened, rather than the
+    // time each of them ends up being processed
+    const uint16_t scan_time      = timer_read();
+    bool           matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
         matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
     }
@@ -569,7 +650,10 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    keyevent_t event = MAKE_KEYEVENT(row, col, key_pressed);
+                    event.time       = scan_time;
+                    LATENCY_TRACE_KEY_EVENT(event);
+                    keyevent_queue_push(event);
                 }
 
                 switch_events(row, col, key_pressed);
@@ -579,6 +663,8 @@ static bool matrix_task(void) {
         matrix_previous[row] = current_row;
     }
 
+    keyevent_queue_drain();
+
     return matrix_changed;
 }
 
@@ -636,6 +722,10 @@ void quantum_task(void) {
     leader_task();
 #endif
 
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_QUEUE_SIZE)
+    send_string_async_task();
+#endif
+
 #ifdef WPM_ENABLE
     decay_wpm();
 #endif
@@ -655,38 +745,79 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
-}
-
-/** \brief Main task that is repeatedly called as fast as possible. */
-void keyboard_task(void) {
-    __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
-        last_matrix_activity_trigger();
-        activity_has_occurred = true;
-    }
 
-    quantum_task();
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_task();
+#endif
 
-#if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_task();
 #endif
+}
 
+/** \brief Updates RGB Light, LED/RGB Matrix and backlight effects. */
+static void lighting_task(void) {
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    SCHEDULED_TASK(SCHEDULED_TASK_RGBLIGHT, rgblight_task());
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    SCHEDULED_TASK(SCHEDULED_TASK_LED_MATRIX, PROFILE_SLOT(PROFILER_SLOT_LED_MATRIX_TASK, led_matrix_task()));
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    SCHEDULED_TASK(SCHEDULED_TASK_RGB_MATRIX, PROFILE_SLOT(PROFILER_SLOT_RGB_MATRIX_TASK, rgb_matrix_task()));
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+    SCHEDULED_TASK(SCHEDULED_TASK_BACKLIGHT, backlight_task());
 #    endif
 #endif
+}
+
+/** \brief Updates OLED and ST7565 displays, waking them on activity. */
+static void display_task(bool activity_has_occurred) {
+#ifdef OLED_ENABLE
+    SCHEDULED_TASK(SCHEDULED_TASK_OLED, PROFILE_SLOT(PROFILER_SLOT_OLED_TASK, oled_task()));
+#    if OLED_TIMEOUT > 0
+    // Wake up oled if user is using those fabulous keys or spinning those encoders!
+    if (activity_has_occurred) oled_on();
+#    endif
+#endif
+
+#ifdef ST7565_ENABLE
+    SCHEDULED_TASK(SCHEDULED_TASK_ST7565, st7565_task());
+#    if ST7565_TIMEOUT > 0
+    // Wake up display if user is using those fabulous keys or spinning those encoders!
+    if (activity_has_occurred) st7565_on();
+#    endif
+#endif
+}
+
+/** \brief Main task that is repeatedly called as fast as possible. */
+void keyboard_task(void) {
+    PROFILER_BEGIN(PROFILER_SLOT_KEYBOARD_TASK);
+#ifdef TASK_SCHEDULER_ENABLE
+    task_scheduler_loop_begin();
+#endif
+
+    __attribute__((unused)) bool activity_has_occurred = false;
+    PROFILER_BEGIN(PROFILER_SLOT_MATRIX_TASK);
+    if (matrix_task()) {
+        last_matrix_activity_trigger();
+        activity_has_occurred = true;
+    }
+    PROFILER_END(PROFILER_SLOT_MATRIX_TASK);
+
+    PROFILE_SLOT(PROFILER_SLOT_QUANTUM_TASK, quantum_task());
+
+#if defined(SPLIT_WATCHDOG_ENABLE)
+    split_watchdog_task();
+#endif
+
+#ifndef TASK_SCHEDULER_ENABLE
+    lighting_task();
+#endif
 
 #ifdef ENCODER_ENABLE
     if (encoder_task()) {
@@ -696,26 +827,16 @@ void keyboard_task(void) {
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
+    PROFILER_BEGIN(PROFILER_SLOT_POINTING_DEVICE_TASK);
     if (pointing_device_task()) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
+    PROFILER_END(PROFILER_SLOT_POINTING_DEVICE_TASK);
 #endif
 
-#ifdef OLED_ENABLE
-    oled_task();
-#    if OLED_TIMEOUT > 0
-    // Wake up oled if user is using those fabulous keys or spinning those encoders!
-    if (activity_has_occurred) oled_on();
-#    endif
-#endif
-
-#ifdef ST7565_ENABLE
-    st7565_task();
-#    if ST7565_TIMEOUT > 0
-    // Wake up display if user is using those fabulous keys or spinning those encoders!
-    if (activity_has_occurred) st7565_on();
-#    endif
+#ifndef TASK_SCHEDULER_ENABLE
+    display_task(activity_has_occurred);
 #endif
 
 #ifdef MOUSEKEY_ENABLE
@@ -745,7 +866,32 @@ void keyboard_task(void) {
 
     led_task();
 
+#ifdef TASK_SCHEDULER_ENABLE
+    // With the scheduler, lighting and displays run last, so that a slow
+    // update cannot delay input handling or report sending within the same loop.
+    lighting_task();
+    display_task(activity_has_occurred);
+#endif
+
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+    PROFILER_END(PROFILER_SLOT_KEYBOARD_TASK);
+
+#ifdef PROFILER_ENABLE
+    profiler_task();
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_task();
+#endif
+
+#ifdef PROCESS_RECORD_PROFILER_ENABLE
+    process_record_profiler_task();
+#endif
+
+#ifdef TASK_SCHEDULER_ENABLE
+    task_scheduler_task();
+#endif
 }
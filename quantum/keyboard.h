@@ -139,6 +139,11 @@ void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timesta
 
 uint32_t get_matrix_scan_rate(void);
 
+#ifdef MATRIX_HAS_GHOST
+void keyboard_update_real_keys(void);
+void keyboard_update_real_key(uint8_t row, uint8_t col, bool real);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -109,3 +109,61 @@ __attribute__((weak)) combo_t* combo_get(uint16_t combo_idx) {
 }
 
 #endif // defined(COMBO_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Chords
+
+#if defined(CHORDS_ENABLE)
+
+_Static_assert(sizeof(chord_keys) / sizeof(uint16_t) <= CHORD_MAX_KEYS, "Number of chord keys exceeds maximum set by CHORD_MAX_KEYS");
+
+uint8_t chord_key_count_raw(void) {
+    return sizeof(chord_keys) / sizeof(uint16_t);
+}
+__attribute__((weak)) uint8_t chord_key_count(void) {
+    return chord_key_count_raw();
+}
+
+uint16_t chord_key_get_keycode_raw(uint8_t key_idx) {
+    return key_idx < chord_key_count_raw() ? pgm_read_word(&chord_keys[key_idx]) : KC_NO;
+}
+__attribute__((weak)) uint16_t chord_key_get_keycode(uint8_t key_idx) {
+    return chord_key_get_keycode_raw(key_idx);
+}
+
+uint16_t chord_count_raw(void) {
+    return sizeof(key_chords) / sizeof(chord_t);
+}
+__attribute__((weak)) uint16_t chord_count(void) {
+    return chord_count_raw();
+}
+
+const chord_t* chord_get_raw(uint16_t chord_idx) {
+    return &key_chords[chord_idx];
+}
+__attribute__((weak)) const chord_t* chord_get(uint16_t chord_idx) {
+    return chord_get_raw(chord_idx);
+}
+
+#endif // defined(CHORDS_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
+uint16_t leader_sequence_node_count_raw(void) {
+    return sizeof(leader_sequences) / sizeof(leader_sequence_node_t);
+}
+__attribute__((weak)) uint16_t leader_sequence_node_count(void) {
+    return leader_sequence_node_count_raw();
+}
+
+const leader_sequence_node_t* leader_sequence_node_get_raw(uint16_t node_idx) {
+    return &leader_sequences[node_idx];
+}
+__attribute__((weak)) const leader_sequence_node_t* leader_sequence_node_get(uint16_t node_idx) {
+    return leader_sequence_node_get_raw(node_idx);
+}
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
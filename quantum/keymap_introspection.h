@@ -67,3 +67,51 @@ combo_t* combo_get_raw(uint16_t combo_idx);
 combo_t* combo_get(uint16_t combo_idx);
 
 #endif // defined(COMBO_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Chords
+
+#if defined(CHORDS_ENABLE)
+
+#    include "process_chords.h"
+
+// Get the number of chord keys defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint8_t chord_key_count_raw(void);
+// Get the number of chord keys defined in the user's keymap, potentially stored dynamically
+uint8_t chord_key_count(void);
+
+// Get the keycode of a chord key, stored in firmware rather than any other persistent storage
+uint16_t chord_key_get_keycode_raw(uint8_t key_idx);
+// Get the keycode of a chord key, potentially stored dynamically
+uint16_t chord_key_get_keycode(uint8_t key_idx);
+
+// Get the number of chords defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint16_t chord_count_raw(void);
+// Get the number of chords defined in the user's keymap, potentially stored dynamically
+uint16_t chord_count(void);
+
+// Get a chord, in flash, stored in firmware rather than any other persistent storage
+const chord_t* chord_get_raw(uint16_t chord_idx);
+// Get a chord, in flash, potentially stored dynamically
+const chord_t* chord_get(uint16_t chord_idx);
+
+#endif // defined(CHORDS_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
+#    include "leader.h"
+
+// Get the number of nodes in the leader sequence trie defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint16_t leader_sequence_node_count_raw(void);
+// Get the number of nodes in the leader sequence trie defined in the user's keymap, potentially stored dynamically
+uint16_t leader_sequence_node_count(void);
+
+// Get a leader sequence trie node, in flash, stored in firmware rather than any other persistent storage
+const leader_sequence_node_t* leader_sequence_node_get_raw(uint16_t node_idx);
+// Get a leader sequence trie node, in flash, potentially stored dynamically
+const leader_sequence_node_t* leader_sequence_node_get(uint16_t node_idx);
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
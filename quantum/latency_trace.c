@@ -0,0 +1,222 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_trace.h"
+#include "profiler.h"
+#include "timer.h"
+#include "debug.h"
+#include "util.h"
+
+#ifdef LATENCY_TRACE_USE_TIMER
+// Millisecond timer; follows simulated time on the test platform
+#    define LATENCY_TRACE_NOW() timer_read32()
+#    define LATENCY_TRACE_TO_US(t) ((t)*1000UL)
+#else
+#    include "timestamp.h"
+#    define LATENCY_TRACE_NOW() timestamp_read()
+#    define LATENCY_TRACE_TO_US(t) TIMESTAMP_TO_US(t)
+#endif
+
+#define LATENCY_TRACE_SUB_BUCKETS (1 << LATENCY_TRACE_SUB_BUCKET_BITS)
+
+typedef struct {
+    keypos_t key;
+    bool     pressed;
+    uint8_t  reached; // bitmask of stages, zero if the slot is free
+    uint32_t scan;
+    uint32_t stamps[LATENCY_STAGE_COUNT];
+} latency_trace_t;
+
+static latency_trace_t latency_traces[LATENCY_TRACE_SLOTS];
+static uint8_t         latency_trace_next    = 0;
+static uint32_t        latency_trace_scan_ts = 0;
+static uint32_t        latency_trace_drops   = 0;
+static latency_stats_t latency_stats[LATENCY_STAGE_COUNT];
+
+// clang-format off
+static const char *const latency_stage_names[LATENCY_STAGE_COUNT] = {
+    [LATENCY_STAGE_MATRIX_TASK]    = "matrix_task",
+    [LATENCY_STAGE_ACTION_EXEC]    = "action_exec",
+    [LATENCY_STAGE_PROCESS_RECORD] = "process_record",
+    [LATENCY_STAGE_HOST_SEND]      = "host_send",
+};
+// clang-format on
+
+static uint8_t latency_trace_bucket(uint32_t us) {
+    if (us < LATENCY_TRACE_SUB_BUCKETS) {
+        return us;
+    }
+    uint8_t  exponent = sizeof(unsigned long) * 8 - 1 - __builtin_clzl(us);
+    uint16_t index    = ((exponent - LATENCY_TRACE_SUB_BUCKET_BITS + 1) << LATENCY_TRACE_SUB_BUCKET_BITS) | ((us >> (exponent - LATENCY_TRACE_SUB_BUCKET_BITS)) & (LATENCY_TRACE_SUB_BUCKETS - 1));
+    return MIN(index, LATENCY_TRACE_BUCKETS - 1);
+}
+
+static uint32_t latency_trace_bucket_upper_bound(uint8_t index) {
+    if (index < LATENCY_TRACE_SUB_BUCKETS) {
+        return index;
+    }
+    uint8_t  exponent = (index >> LATENCY_TRACE_SUB_BUCKET_BITS) + LATENCY_TRACE_SUB_BUCKET_BITS - 1;
+    uint32_t mantissa = (index & (LATENCY_TRACE_SUB_BUCKETS - 1)) | LATENCY_TRACE_SUB_BUCKETS;
+    return ((mantissa + 1) << (exponent - LATENCY_TRACE_SUB_BUCKET_BITS)) - 1;
+}
+
+static void latency_trace_complete(latency_trace_t *trace) {
+    for (uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        if (!(trace->reached & (1 << stage))) {
+            continue;
+        }
+        latency_stats_t *stats   = &latency_stats[stage];
+        uint32_t         latency = LATENCY_TRACE_TO_US((uint32_t)(trace->stamps[stage] - trace->scan));
+        stats->max               = MAX(stats->max, latency);
+        stats->count++;
+
+        uint16_t *bucket = &stats->histogram[latency_trace_bucket(latency)];
+        if (*bucket < UINT16_MAX) {
+            (*bucket)++;
+        }
+    }
+    trace->reached = 0;
+}
+
+void latency_trace_reset(void) {
+    memset(latency_traces, 0, sizeof(latency_traces));
+    memset(latency_stats, 0, sizeof(latency_stats));
+    latency_trace_drops = 0;
+}
+
+void latency_trace_scan_begin(void) {
+    latency_trace_scan_ts = LATENCY_TRACE_NOW();
+}
+
+void latency_trace_key_event(keyevent_t event) {
+    latency_trace_t *trace = &latency_traces[latency_trace_next];
+    if (trace->reached) {
+        // Out of slots, the oldest trace is lost
+        latency_trace_drops++;
+    }
+    latency_trace_next = (latency_trace_next + 1) % LATENCY_TRACE_SLOTS;
+
+    trace->key                               = event.key;
+    trace->pressed                           = event.pressed;
+    trace->scan                              = latency_trace_scan_ts;
+    trace->stamps[LATENCY_STAGE_MATRIX_TASK] = LATENCY_TRACE_NOW();
+    trace->reached                           = 1 << LATENCY_STAGE_MATRIX_TASK;
+}
+
+void latency_trace_stamp(latency_stage_t stage, keyevent_t event) {
+    if (!IS_KEYEVENT(event)) {
+        return;
+    }
+
+    // Prefer the oldest trace for this key that has yet to reach the stage.
+    // Otherwise restamp the latest one, as the event is being replayed (e.g.
+    // out of the tapping or combo buffers).
+    latency_trace_t *match = NULL;
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        latency_trace_t *trace = &latency_traces[(latency_trace_next + i) % LATENCY_TRACE_SLOTS];
+        if (!trace->reached || !KEYEQ(trace->key, event.key) || trace->pressed != event.pressed) {
+            continue;
+        }
+        match = trace;
+        if (!(trace->reached & (1 << stage))) {
+            break;
+        }
+    }
+
+    if (match) {
+        match->stamps[stage] = LATENCY_TRACE_NOW();
+        match->reached |= 1 << stage;
+    }
+}
+
+void latency_trace_host_send(void) {
+    const uint32_t now = LATENCY_TRACE_NOW();
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        latency_trace_t *trace = &latency_traces[i];
+        if (trace->reached & (1 << LATENCY_STAGE_PROCESS_RECORD)) {
+            trace->stamps[LATENCY_STAGE_HOST_SEND] = now;
+            trace->reached |= 1 << LATENCY_STAGE_HOST_SEND;
+            latency_trace_complete(trace);
+        }
+    }
+}
+
+const char *latency_trace_get_stage_name(latency_stage_t stage) {
+    return stage < LATENCY_STAGE_COUNT ? latency_stage_names[stage] : NULL;
+}
+
+uint32_t latency_trace_dropped(void) {
+    return latency_trace_drops;
+}
+
+const latency_stats_t *latency_trace_get_stats(latency_stage_t stage) {
+    return stage < LATENCY_STAGE_COUNT ? &latency_stats[stage] : NULL;
+}
+
+uint32_t latency_trace_percentile(latency_stage_t stage, uint8_t percent) {
+    if (stage >= LATENCY_STAGE_COUNT || latency_stats[stage].count == 0) {
+        return 0;
+    }
+
+    const latency_stats_t *stats  = &latency_stats[stage];
+    uint32_t               target = ((uint64_t)stats->count * MIN(percent, 100) + 99) / 100;
+    uint32_t               seen   = 0;
+    for (uint8_t bucket = 0; bucket < LATENCY_TRACE_BUCKETS; bucket++) {
+        seen += stats->histogram[bucket];
+        if (seen >= MAX(target, 1)) {
+            return MIN(latency_trace_bucket_upper_bound(bucket), stats->max);
+        }
+    }
+    return stats->max;
+}
+
+void latency_trace_print(void) {
+    for (uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        dprintf("latency %-14s n=%lu p50=%luus p99=%luus max=%luus\n", latency_trace_get_stage_name(stage), latency_stats[stage].count, latency_trace_percentile(stage, 50), latency_trace_percentile(stage, 99), latency_stats[stage].max);
+    }
+    if (latency_trace_drops) {
+        dprintf("latency traces dropped: %lu\n", latency_trace_drops);
+    }
+}
+
+void latency_trace_task(void) {
+    static uint32_t last_print = 0;
+    profiler_print_every(&last_print, LATENCY_TRACE_PRINT_INTERVAL, latency_trace_print);
+}
+
+bool latency_trace_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, latency_command, stage, payload... ]
+    if (!profiler_raw_hid_is_for(data, length, LATENCY_TRACE_RAW_HID_COMMAND_ID)) {
+        return false;
+    }
+
+    uint8_t *command = &data[1];
+    uint8_t  stage   = data[2];
+    uint8_t *payload = &data[3];
+
+    switch (*command) {
+        case latency_trace_raw_hid_get_stats: {
+            // payload = [ count, p50, p99, max, dropped ], little endian, in microseconds
+            if (stage >= LATENCY_STAGE_COUNT || length < 3 + 20) {
+                *command = PROFILER_RAW_HID_ERROR;
+                break;
+            }
+            profiler_pack_u32(&payload[0], latency_stats[stage].count);
+            profiler_pack_u32(&payload[4], latency_trace_percentile(stage, 50));
+            profiler_pack_u32(&payload[8], latency_trace_percentile(stage, 99));
+            profiler_pack_u32(&payload[12], latency_stats[stage].max);
+            profiler_pack_u32(&payload[16], latency_trace_drops);
+            break;
+        }
+        case latency_trace_raw_hid_reset: {
+            latency_trace_reset();
+            break;
+        }
+        default: {
+            *command = PROFILER_RAW_HID_ERROR;
+            break;
+        }
+    }
+    return true;
+}
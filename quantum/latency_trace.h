@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+
+/*
+    Keypress latency tracer.
+
+    Each key event produced by matrix_task() is stamped with the time its scan
+    started, then again as it passes through action_exec(),
+    process_record_quantum() and finally the next keyboard or NKRO report. The
+    latency of every stage, relative to the scan, is accumulated into a
+    log-linear histogram from which percentiles can be read.
+
+    A trace completes at the first keyboard report sent after the event
+    reaches process_record_quantum(), so keys that never change the report
+    (e.g. layer keys) are attributed the latency of the next report. Keys
+    swallowed by a combo are attributed the latency of the combo.
+*/
+
+#ifndef LATENCY_TRACE_SLOTS
+#    define LATENCY_TRACE_SLOTS 8
+#endif
+
+// 4 buckets per power of two, i.e. percentiles are accurate to within 25%
+#define LATENCY_TRACE_SUB_BUCKET_BITS 2
+
+#ifndef LATENCY_TRACE_BUCKETS
+#    define LATENCY_TRACE_BUCKETS 96
+#endif
+
+#ifndef LATENCY_TRACE_PRINT_INTERVAL
+#    define LATENCY_TRACE_PRINT_INTERVAL 10000
+#endif
+
+#ifndef LATENCY_TRACE_RAW_HID_COMMAND_ID
+#    define LATENCY_TRACE_RAW_HID_COMMAND_ID 0xF1
+#endif
+
+typedef enum {
+    LATENCY_STAGE_MATRIX_TASK,
+    LATENCY_STAGE_ACTION_EXEC,
+    LATENCY_STAGE_PROCESS_RECORD,
+    LATENCY_STAGE_HOST_SEND,
+    LATENCY_STAGE_COUNT,
+} latency_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t max;
+    uint16_t histogram[LATENCY_TRACE_BUCKETS];
+} latency_stats_t;
+
+enum latency_trace_raw_hid_command {
+    latency_trace_raw_hid_get_stats = 0x01,
+    latency_trace_raw_hid_reset     = 0x02,
+};
+
+void                   latency_trace_reset(void);
+void                   latency_trace_scan_begin(void);
+void                   latency_trace_key_event(keyevent_t event);
+void                   latency_trace_stamp(latency_stage_t stage, keyevent_t event);
+void                   latency_trace_host_send(void);
+const char            *latency_trace_get_stage_name(latency_stage_t stage);
+uint32_t               latency_trace_dropped(void);
+const latency_stats_t *latency_trace_get_stats(latency_stage_t stage);
+uint32_t               latency_trace_percentile(latency_stage_t stage, uint8_t percent);
+void                   latency_trace_print(void);
+void                   latency_trace_task(void);
+bool                   latency_trace_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#ifdef LATENCY_TRACE_ENABLE
+#    define LATENCY_TRACE_SCAN_BEGIN() latency_trace_scan_begin()
+#    define LATENCY_TRACE_KEY_EVENT(event) latency_trace_key_event(event)
+#    define LATENCY_TRACE_STAMP(stage, event) latency_trace_stamp(stage, event)
+#    define LATENCY_TRACE_HOST_SEND() latency_trace_host_send()
+#else
+#    define LATENCY_TRACE_SCAN_BEGIN()
+#    define LATENCY_TRACE_KEY_EVENT(event)
+#    define LATENCY_TRACE_STAMP(stage, event)
+#    define LATENCY_TRACE_HOST_SEND()
+#endif
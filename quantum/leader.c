@@ -7,20 +7,77 @@
 
 #include <string.h>
 
+#if defined(LEADER_SEQUENCES_ENABLE)
+#    include "quantum.h"
+#    include "keymap_introspection.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
 
+// leader_sequence_is() always looks at the first five keys
+#if LEADER_SEQUENCE_MAX_LENGTH < 5
+#    error "LEADER_SEQUENCE_MAX_LENGTH must be at least 5"
+#endif
+
 // Leader key stuff
-bool     leading              = false;
-uint16_t leader_time          = 0;
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+bool     leading                                     = false;
+uint16_t leader_time                                 = 0;
+uint16_t leader_sequence[LEADER_SEQUENCE_MAX_LENGTH] = {0};
+uint8_t  leader_sequence_size                        = 0;
 
 __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
 
+#if defined(LEADER_SEQUENCES_ENABLE)
+#    define LEADER_TRIE_NONE UINT16_MAX
+
+// The span of trie nodes that may follow the current sequence, and the node it has reached so far
+static uint16_t leader_trie_first = 0;
+static uint16_t leader_trie_end   = 0;
+static uint16_t leader_trie_node  = LEADER_TRIE_NONE;
+
+__attribute__((weak)) bool leader_sequence_matched_user(uint16_t keycode) {
+    return true;
+}
+
+static void leader_trie_reset(void) {
+    leader_trie_first = 0;
+    leader_trie_end   = leader_sequence_node_count();
+    leader_trie_node  = LEADER_TRIE_NONE;
+}
+
+// Moves down to the child reached by the keycode, stepping over the descendants of the other children
+static void leader_trie_advance(uint16_t keycode) {
+    uint16_t node = leader_trie_first;
+    while (node < leader_trie_end) {
+        const leader_sequence_node_t *entry       = leader_sequence_node_get(node);
+        const uint16_t                descendants = pgm_read_word(&entry->descendants);
+        if (pgm_read_word(&entry->keycode) == keycode) {
+            leader_trie_node  = node;
+            leader_trie_first = node + 1;
+            leader_trie_end   = node + 1 + descendants;
+            return;
+        }
+        node += 1 + descendants;
+    }
+
+    // No sequence starts this way
+    leader_trie_node  = LEADER_TRIE_NONE;
+    leader_trie_first = 0;
+    leader_trie_end   = 0;
+}
+
+uint16_t leader_sequence_result(void) {
+    if (leader_trie_node == LEADER_TRIE_NONE) {
+        return KC_NO;
+    }
+    return pgm_read_word(&leader_sequence_node_get(leader_trie_node)->result);
+}
+#endif
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -30,11 +87,23 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#if defined(LEADER_SEQUENCES_ENABLE)
+    leader_trie_reset();
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#if defined(LEADER_SEQUENCES_ENABLE)
+    const uint16_t result = leader_sequence_result();
+    if (result != KC_NO && leader_sequence_matched_user(result)) {
+        tap_code16(result);
+    }
+#endif
     leader_end_user();
+#if defined(LEADER_SEQUENCES_ENABLE)
+    leader_trie_node = LEADER_TRIE_NONE;
+#endif
 }
 
 void leader_task(void) {
@@ -61,6 +130,15 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
+#if defined(LEADER_SEQUENCES_ENABLE)
+    leader_trie_advance(keycode);
+
+    // A leaf can't be extended any further, so don't wait for the timeout
+    if (leader_trie_node != LEADER_TRIE_NONE && leader_trie_first == leader_trie_end) {
+        leader_end();
+    }
+#endif
+
     return true;
 }
 
@@ -77,7 +155,7 @@ void leader_reset_timer(void) {
 }
 
 bool leader_sequence_is(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_t kc4, uint16_t kc5) {
-    return leader_sequence[0] == kc1 && leader_sequence[1] == kc2 && leader_sequence[2] == kc3 && leader_sequence[3] == kc4 && leader_sequence[4] == kc5;
+    return leader_sequence_size <= 5 && leader_sequence[0] == kc1 && leader_sequence[1] == kc2 && leader_sequence[2] == kc3 && leader_sequence[3] == kc4 && leader_sequence[4] == kc5;
 }
 
 bool leader_sequence_one_key(uint16_t kc) {
@@ -1,9 +1,15 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
+#ifndef LEADER_SEQUENCE_MAX_LENGTH
+#    define LEADER_SEQUENCE_MAX_LENGTH 5
+#endif
+
 /**
  * \file
  *
@@ -33,6 +39,41 @@ void leader_end(void);
 
 void leader_task(void);
 
+#if defined(LEADER_SEQUENCES_ENABLE)
+/**
+ * A node of the leader sequence trie.
+ *
+ * The trie is stored in pre-order: a node's children directly follow it, and
+ * its next sibling follows all of its descendants. The first level of the
+ * trie starts at index 0.
+ */
+typedef struct {
+    /** The key pressed to reach this node. */
+    uint16_t keycode;
+    /** The number of nodes below this one. */
+    uint16_t descendants;
+    /** The keycode to send if the sequence ends here, or `KC_NO`. */
+    uint16_t result;
+} leader_sequence_node_t;
+
+/**
+ * \brief User callback, invoked when the leader sequence matches an entry of
+ * the sequence trie.
+ *
+ * \param keycode The result of the matching sequence.
+ *
+ * \return `true` to send the keycode with `tap_code16()`, `false` if it was
+ * handled already.
+ */
+bool leader_sequence_matched_user(uint16_t keycode);
+
+/**
+ * The result of the sequence trie entry matching the current sequence, or
+ * `KC_NO` if there is none.
+ */
+uint16_t leader_sequence_result(void);
+#endif
+
 /**
  * Whether the leader sequence is active.
  */
@@ -43,6 +84,10 @@ bool leader_sequence_active(void);
  *
  * If `LEADER_NO_TIMEOUT` is defined, the timer is reset if the buffer is empty.
  *
+ * If `LEADER_SEQUENCES_ENABLE` is defined, the sequence trie is advanced by
+ * the keycode, and the sequence ends right away if it can only match a single
+ * entry.
+ *
  * \param keycode The keycode to add.
  *
  * \return `true` if the keycode was added, `false` if the buffer is full.
@@ -15,6 +15,7 @@
  */
 
 #include "keyboard.h"
+#include "task_scheduler.h"
 
 void platform_setup(void);
 
@@ -62,7 +63,7 @@ int main(void) {
 #ifdef QUANTUM_PAINTER_ENABLE
         // Run Quantum Painter task
         void qp_internal_task(void);
-        qp_internal_task();
+        SCHEDULED_TASK(SCHEDULED_TASK_QUANTUM_PAINTER, qp_internal_task());
 #endif
 
 #ifdef DEFERRED_EXEC_ENABLE
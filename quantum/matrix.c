@@ -22,6 +22,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "debounce.h"
 #include "atomic_util.h"
 
+#ifdef MATRIX_BACKGROUND_SCAN_ENABLE
+#    include "matrix_background.h"
+#endif
+
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -104,6 +108,102 @@ static inline uint8_t readMatrixPin(pin_t pin) {
     }
 }
 
+#ifdef MATRIX_READ_BY_PORT
+#    if defined(DIRECT_PINS) || !defined(DIODE_DIRECTION)
+#        error MATRIX_READ_BY_PORT requires DIODE_DIRECTION to be COL2ROW or ROW2COL
+#    endif
+#    ifndef gpio_read_port
+#        error MATRIX_READ_BY_PORT is not supported on this platform
+#    endif
+
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_INPUT_PINS col_pins
+#        define MATRIX_INPUT_COUNT MATRIX_COLS
+#    else
+#        define MATRIX_INPUT_PINS row_pins
+#        define MATRIX_INPUT_COUNT ROWS_PER_HAND
+_Static_assert(ROWS_PER_HAND <= 32, "MATRIX_READ_BY_PORT supports at most 32 rows per hand");
+#    endif
+
+// A run of input pins on consecutive pads of one port, mapping to consecutive rows or columns
+typedef struct {
+    gpio_port_data_t mask;  // mask of the run, after shifting down by pad
+    uint8_t          port;  // index into input_ports
+    uint8_t          pad;   // pad of the first pin of the run
+    uint8_t          index; // row or column of the first pin of the run
+    uint8_t          width;
+} matrix_pin_run_t;
+
+static gpio_port_t      input_ports[MATRIX_INPUT_COUNT];
+static uint8_t          input_port_count = 0;
+static matrix_pin_run_t input_runs[MATRIX_INPUT_COUNT];
+static uint8_t          input_run_count = 0;
+
+/* Groups the input pins by port, so that each port only needs reading once
+ * per strobe, and precomputes how to scatter the port bits into the matrix.
+ */
+static void matrix_init_input_ports(void) {
+    input_port_count = 0;
+    input_run_count  = 0;
+
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+        const pin_t pin = MATRIX_INPUT_PINS[i];
+        if (pin == NO_PIN) {
+            continue;
+        }
+
+        const gpio_port_t port = gpio_get_pin_port(pin);
+        const uint8_t     pad  = gpio_get_pin_pad(pin);
+
+        uint8_t port_index = 0;
+        while (port_index < input_port_count && input_ports[port_index] != port) {
+            port_index++;
+        }
+        if (port_index == input_port_count) {
+            input_ports[input_port_count++] = port;
+        }
+
+        // Extend the previous run if this pin directly follows it
+        if (input_run_count) {
+            matrix_pin_run_t *run = &input_runs[input_run_count - 1];
+            if (run->port == port_index && run->pad + run->width == pad && run->index + run->width == i) {
+                run->mask = (run->mask << 1) | 1;
+                run->width++;
+                continue;
+            }
+        }
+
+        input_runs[input_run_count++] = (matrix_pin_run_t){
+            .mask  = 1,
+            .port  = port_index,
+            .pad   = pad,
+            .index = i,
+            .width = 1,
+        };
+    }
+}
+
+/* Returns a bitmask of the pressed inputs, bit n being row or column n.
+ */
+static uint32_t matrix_read_input_ports(void) {
+    gpio_port_data_t port_data[MATRIX_INPUT_COUNT];
+    for (uint8_t i = 0; i < input_port_count; i++) {
+#    if MATRIX_INPUT_PRESSED_STATE == 0
+        port_data[i] = ~gpio_read_port(input_ports[i]);
+#    else
+        port_data[i] = gpio_read_port(input_ports[i]);
+#    endif
+    }
+
+    uint32_t pressed = 0;
+    for (uint8_t i = 0; i < input_run_count; i++) {
+        const matrix_pin_run_t *run = &input_runs[i];
+        pressed |= (uint32_t)((port_data[run->port] >> run->pad) & run->mask) << run->index;
+    }
+    return pressed;
+}
+#endif
+
 // matrix code
 
 #ifdef DIRECT_PINS
@@ -181,6 +281,9 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_BY_PORT
+    current_row_value = (matrix_row_t)matrix_read_input_ports();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -189,6 +292,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -244,10 +348,18 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_BY_PORT
+    const uint32_t rows_pressed = matrix_read_input_ports();
+#            endif
+
     // For each row...
     for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
         // Check row pin state
+#            ifdef MATRIX_READ_BY_PORT
+        if (rows_pressed & ((uint32_t)1 << row_index)) {
+#            else
         if (readMatrixPin(row_pins[row_index]) == 0) {
+#            endif
             // Pin LO, set col bit
             current_matrix[row_index] |= row_shifter;
             key_pressed = true;
@@ -270,6 +382,22 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_BACKGROUND_SCAN_ENABLE
+#    if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_BACKGROUND_LINES ROWS_PER_HAND
+#    else
+#        define MATRIX_BACKGROUND_LINES MATRIX_COLS
+#    endif
+
+void matrix_background_read_line(matrix_row_t current_matrix[], uint8_t line) {
+#    if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
+    matrix_read_cols_on_row(current_matrix, line);
+#    elif (DIODE_DIRECTION == ROW2COL)
+    matrix_read_rows_on_col(current_matrix, line, MATRIX_ROW_SHIFTER << line);
+#    endif
+}
+#endif
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -302,6 +430,9 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_READ_BY_PORT
+    matrix_init_input_ports();
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
@@ -309,6 +440,10 @@ void matrix_init(void) {
 
     debounce_init(ROWS_PER_HAND);
 
+#ifdef MATRIX_BACKGROUND_SCAN_ENABLE
+    matrix_background_init(ROWS_PER_HAND, MATRIX_BACKGROUND_LINES);
+#endif
+
     matrix_init_kb();
 }
 
@@ -323,7 +458,10 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 uint8_t matrix_scan(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
-#if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
+#if defined(MATRIX_BACKGROUND_SCAN_ENABLE)
+    // Pick up the latest snapshot taken by the background scan
+    matrix_background_read(curr_matrix);
+#elif defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
         matrix_read_cols_on_row(curr_matrix, current_row);
@@ -0,0 +1,52 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "matrix_background.h"
+#include "atomic_util.h"
+
+static matrix_row_t      buffers[2][MATRIX_ROWS];
+static volatile uint8_t  front      = 0;
+static volatile bool     fresh      = false;
+static volatile uint32_t scan_count = 0;
+static uint8_t           scan_rows  = 0;
+static uint8_t           scan_lines = 0;
+
+void matrix_background_init(uint8_t rows, uint8_t lines) {
+    memset(buffers, 0, sizeof(buffers));
+    front      = 0;
+    fresh      = false;
+    scan_count = 0;
+    scan_rows  = rows;
+    scan_lines = lines;
+
+    matrix_background_driver_init();
+}
+
+void matrix_background_scan(void) {
+    // The back buffer is never read, so it can be written without locking
+    matrix_row_t *back = buffers[front ^ 1];
+    for (uint8_t line = 0; line < scan_lines; line++) {
+        matrix_background_read_line(back, line);
+    }
+
+    front ^= 1;
+    fresh = true;
+    scan_count++;
+}
+
+bool matrix_background_read(matrix_row_t matrix[]) {
+    bool was_fresh;
+    // Keep the buffers from being swapped, and the one being copied from
+    // being rewritten, until the copy is done
+    ATOMIC_BLOCK_FORCEON {
+        memcpy(matrix, buffers[front], scan_rows * sizeof(matrix_row_t));
+        was_fresh = fresh;
+        fresh     = false;
+    }
+    return was_fresh;
+}
+
+uint32_t matrix_background_scan_count(void) {
+    return scan_count;
+}
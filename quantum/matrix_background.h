@@ -0,0 +1,45 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+
+/*
+    Background matrix scanning.
+
+    Rather than strobing the matrix from matrix_scan(), a platform driver runs
+    a full scan pass at MATRIX_BACKGROUND_SCAN_RATE, independently of the main
+    loop. Each pass is written into a back buffer which is only published once
+    complete, so matrix_scan() always sees a consistent snapshot no matter when
+    it runs.
+*/
+
+#ifndef MATRIX_BACKGROUND_SCAN_RATE
+// Scan passes per second
+#    define MATRIX_BACKGROUND_SCAN_RATE 2000
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Starts scanning `lines` strobe lines into a matrix of `rows` rows. */
+void matrix_background_init(uint8_t rows, uint8_t lines);
+/* Runs a full scan pass and publishes it. Called by the driver, at MATRIX_BACKGROUND_SCAN_RATE. */
+void matrix_background_scan(void);
+/* Copies the latest complete snapshot, returns true if it is newer than the last one read. */
+bool matrix_background_read(matrix_row_t matrix[]);
+/* Number of scan passes completed since init. */
+uint32_t matrix_background_scan_count(void);
+
+/* Strobes one line and reads it into `matrix`, implemented by the matrix. */
+void matrix_background_read_line(matrix_row_t matrix[], uint8_t line);
+
+/* Starts the platform timer that drives matrix_background_scan(). */
+void matrix_background_driver_init(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,6 +25,7 @@
 #ifdef OS_DETECTION_DEBUG_ENABLE
 #    include "eeconfig.h"
 #    include "eeprom.h"
+#    include "eeprom_write_behind.h"
 #    include "print.h"
 
 #    define STORED_USB_SETUPS 50
@@ -181,19 +182,19 @@ void slave_update_detected_host_os(os_variant_t os) {
 #ifdef OS_DETECTION_DEBUG_ENABLE
 void print_stored_setups(void) {
 #    ifdef CONSOLE_ENABLE
-    uint8_t cnt = eeprom_read_byte(EEPROM_USER_OFFSET);
+    uint8_t cnt = eeprom_write_behind_read_byte(EEPROM_USER_OFFSET);
     for (uint16_t i = 0; i < cnt; ++i) {
         uint16_t* addr = (uint16_t*)EEPROM_USER_OFFSET + i * sizeof(uint16_t) + sizeof(uint8_t);
-        xprintf("i: %d, wLength: 0x%02X\n", i, eeprom_read_word(addr));
+        xprintf("i: %d, wLength: 0x%02X\n", i, eeprom_write_behind_read_word(addr));
     }
 #    endif
 }
 
 void store_setups_in_eeprom(void) {
-    eeprom_update_byte(EEPROM_USER_OFFSET, setups_data.count);
+    eeprom_write_behind_update_byte(EEPROM_USER_OFFSET, setups_data.count);
     for (uint16_t i = 0; i < setups_data.count; ++i) {
         uint16_t* addr = (uint16_t*)EEPROM_USER_OFFSET + i * sizeof(uint16_t) + sizeof(uint8_t);
-        eeprom_update_word(addr, usb_setups[i]);
+        eeprom_write_behind_update_word(addr, usb_setups[i]);
     }
 }
 
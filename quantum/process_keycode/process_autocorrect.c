@@ -296,6 +296,8 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             return true;
         } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
             ++state;
+        } else if (code == 1) { // Follow link from a chain to a shared child node.
+            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
         }
 
         // Stop if `state` becomes an invalid index. This should not normally
@@ -0,0 +1,96 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "process_chords.h"
+#include "keycodes.h"
+#include "quantum.h"
+#include "keymap_introspection.h"
+
+static uint32_t chord_pressed[CHORD_MASK_WORDS];
+static uint32_t chord_union[CHORD_MASK_WORDS];
+
+static inline bool chord_mask_is_empty(const uint32_t mask[CHORD_MASK_WORDS]) {
+    for (uint8_t word = 0; word < CHORD_MASK_WORDS; word++) {
+        if (mask[word]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Compares a mask in RAM against one in flash, most significant word first
+static inline int8_t chord_mask_compare(const uint32_t mask[CHORD_MASK_WORDS], const uint32_t *chord_mask) {
+    for (uint8_t word = CHORD_MASK_WORDS; word-- > 0;) {
+        uint32_t other = pgm_read_dword(&chord_mask[word]);
+        if (mask[word] != other) {
+            return mask[word] < other ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static int8_t chord_key_index(uint16_t keycode) {
+    for (uint8_t index = 0; index < chord_key_count(); index++) {
+        if (chord_key_get_keycode(index) == keycode) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+uint16_t chord_lookup(const uint32_t mask[CHORD_MASK_WORDS]) {
+    uint16_t low = 0, high = chord_count();
+    while (low < high) {
+        uint16_t       mid   = low + (high - low) / 2;
+        const chord_t *chord = chord_get(mid);
+        int8_t         order = chord_mask_compare(mask, chord->mask);
+        if (order == 0) {
+            return pgm_read_word(&chord->keycode);
+        }
+        if (order < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return KC_NO;
+}
+
+__attribute__((weak)) void process_chord_miss(const uint32_t mask[CHORD_MASK_WORDS]) {
+    for (uint8_t index = 0; index < chord_key_count(); index++) {
+        if (mask[index / 32] & ((uint32_t)1 << (index % 32))) {
+            tap_code16(chord_key_get_keycode(index));
+        }
+    }
+}
+
+bool process_chords(uint16_t keycode, keyrecord_t *record) {
+    int8_t index = chord_key_index(keycode);
+    if (index < 0) {
+        return true;
+    }
+
+    const uint8_t  word = index / 32;
+    const uint32_t bit  = (uint32_t)1 << (index % 32);
+
+    if (record->event.pressed) {
+        chord_pressed[word] |= bit;
+        chord_union[word] |= bit;
+        return false;
+    }
+
+    chord_pressed[word] &= ~bit;
+    if (!chord_mask_is_empty(chord_pressed) || chord_mask_is_empty(chord_union)) {
+        return false;
+    }
+
+    uint16_t chord_keycode = chord_lookup(chord_union);
+    if (chord_keycode != KC_NO) {
+        tap_code16(chord_keycode);
+    } else {
+        process_chord_miss(chord_union);
+    }
+    memset(chord_union, 0, sizeof(chord_union));
+    return false;
+}
@@ -0,0 +1,66 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+
+/*
+    Chording engine for large, steno-style chord sets.
+
+    Every keycode in chord_keys[] is given a bit in a wide bitset. While chord
+    keys are held, the union of all keys pressed is collected; once they have
+    all been released, that mask is looked up in key_chords[] by binary
+    search and the matching keycode is tapped. Key presses cost a scan of
+    chord_keys[] and releases a single O(log n) lookup, no matter how many
+    chords are defined. Both tables live in flash, and are generated from the
+    "chords" section of keymap.json.
+
+    key_chords[] must be sorted by mask, compared as unsigned integers with
+    mask[0] holding the lowest 32 bits, and masks must be unique.
+*/
+
+#ifndef CHORD_MAX_KEYS
+#    define CHORD_MAX_KEYS 64
+#endif
+
+// Chord keys are indexed with int8_t
+#if CHORD_MAX_KEYS > 127
+#    error "CHORD_MAX_KEYS must not be greater than 127"
+#endif
+
+#define CHORD_MASK_WORDS ((CHORD_MAX_KEYS + 31) / 32)
+
+typedef struct {
+    uint32_t mask[CHORD_MASK_WORDS];
+    uint16_t keycode;
+} chord_t;
+
+/**
+ * @brief Handles chord keys
+ *
+ * @param keycode the keycode
+ * @param record the key record structure
+ * @return true continue handling keycodes
+ * @return false stop handling keycodes
+ */
+bool process_chords(uint16_t keycode, keyrecord_t *record);
+
+/**
+ * @brief Called when the released keys do not form a chord
+ *
+ * The default implementation taps each key of the mask, in chord_keys[]
+ * order.
+ *
+ * @param mask the keys that were pressed
+ */
+void process_chord_miss(const uint32_t mask[CHORD_MASK_WORDS]);
+
+/**
+ * @brief Looks up the chord for a mask
+ *
+ * @return the chord's keycode, or KC_NO if there is none
+ */
+uint16_t chord_lookup(const uint32_t mask[CHORD_MASK_WORDS]);
@@ -26,6 +26,8 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "latency_trace.h"
+#include "debug.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -94,6 +96,23 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_INDEX_SIZE
+/* Every key of every combo, sorted by keycode, so that a key event only
+ * visits the combos containing its keycode. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_index_entry_t;
+static combo_index_entry_t combo_index[COMBO_INDEX_SIZE];
+static uint16_t            combo_index_size       = 0;
+static bool                combo_index_built      = false;
+static bool                combo_index_overflowed = false;
+// Whether any combo may hold state that clear_combos() has to reset
+static bool combos_dirty = false;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -194,11 +213,23 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_INDEX_SIZE
+    if (!combos_dirty) {
+        return;
+    }
+    combos_dirty = false;
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
             RESET_COMBO_STATE(combo);
         }
+#ifdef COMBO_INDEX_SIZE
+        else {
+            // Needs re-enabling once it has been released
+            combos_dirty = true;
+        }
+#endif
     }
 }
 
@@ -330,6 +361,8 @@ void apply_combo(uint16_t combo_index, combo_t *combo) {
         }
 
         KEY_STATE_DOWN(state, key_index);
+        // The combo stands in for the key, which never gets processed itself
+        LATENCY_TRACE_STAMP(LATENCY_STAGE_PROCESS_RECORD, record->event);
         if (ALL_COMBO_KEYS_ARE_DOWN(state, key_count)) {
             // this in the end executes the combo when the key_buffer is dumped.
             record->keycode    = combo->keycode;
@@ -414,16 +447,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return false;
-    }
-
+static bool process_combo_key(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index, uint16_t key_index, uint8_t key_count) {
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -437,6 +461,9 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
         uint16_t time = _get_combo_term(combo_index, combo);
         if (!COMBO_ACTIVE(combo)) {
             KEY_STATE_DOWN(combo->state, key_index);
+#ifdef COMBO_INDEX_SIZE
+            combos_dirty = true;
+#endif
             if (longest_term < time) {
                 longest_term = time;
             }
@@ -508,6 +535,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 #endif
         } else if (COMBO_ACTIVE(combo) && ONLY_ONE_KEY_IS_DOWN(COMBO_STATE(combo)) && KEY_NOT_YET_RELEASED(COMBO_STATE(combo), key_index)) {
             /* last key released */
+            LATENCY_TRACE_STAMP(LATENCY_STAGE_PROCESS_RECORD, record->event);
             release_combo(combo_index, combo);
             key_is_part_of_combo = true;
 
@@ -517,6 +545,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
         } else if (COMBO_ACTIVE(combo) && KEY_NOT_YET_RELEASED(COMBO_STATE(combo), key_index)) {
             /* first or middle key released */
             key_is_part_of_combo = true;
+            LATENCY_TRACE_STAMP(LATENCY_STAGE_PROCESS_RECORD, record->event);
 
 #ifdef COMBO_PROCESS_KEY_RELEASE
             if (process_combo_key_release(combo_index, combo, key_index, keycode)) {
@@ -534,6 +563,89 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    uint8_t  key_count = 0;
+    uint16_t key_index = -1;
+    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+
+    /* Continue processing if key isn't part of current combo. */
+    if (-1 == (int16_t)key_index) {
+        return false;
+    }
+
+    return process_combo_key(combo, keycode, record, combo_index, key_index, key_count);
+}
+
+#ifdef COMBO_INDEX_SIZE
+void combo_index_invalidate(void) {
+    combo_index_built = false;
+}
+
+static void combo_index_build(void) {
+    combo_index_size       = 0;
+    combo_index_overflowed = false;
+    combo_index_built      = true;
+    combos_dirty           = true;
+
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        const uint16_t *keys      = combo_get(idx)->keys;
+        uint8_t         key_count = 0;
+        while (pgm_read_word(&keys[key_count]) != COMBO_END) {
+            key_count++;
+        }
+
+        for (uint8_t key_index = 0; key_index < key_count; key_index++) {
+            uint16_t keycode = pgm_read_word(&keys[key_index]);
+            // A key listed twice is matched by its last position, as in _find_key_index_and_count()
+            bool repeated = false;
+            for (uint8_t later = key_index + 1; later < key_count; later++) {
+                repeated |= pgm_read_word(&keys[later]) == keycode;
+            }
+            if (repeated) {
+                continue;
+            }
+
+            if (combo_index_size == COMBO_INDEX_SIZE) {
+                dprintf("combo: index needs more than %u entries, falling back to scanning all combos\n", COMBO_INDEX_SIZE);
+                combo_index_overflowed = true;
+                return;
+            }
+
+            // Insertion sort by keycode, keeping combos with the same keycode in order
+            uint16_t pos = combo_index_size++;
+            for (; pos > 0 && combo_index[pos - 1].keycode > keycode; pos--) {
+                combo_index[pos] = combo_index[pos - 1];
+            }
+            combo_index[pos] = (combo_index_entry_t){
+                .keycode     = keycode,
+                .combo_index = idx,
+                .key_index   = key_index,
+                .key_count   = key_count,
+            };
+        }
+    }
+}
+
+static bool process_indexed_combos(uint16_t keycode, keyrecord_t *record) {
+    uint16_t low = 0, high = combo_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    bool is_combo_key = false;
+    for (uint16_t i = low; i < combo_index_size && combo_index[i].keycode == keycode; i++) {
+        const combo_index_entry_t *entry = &combo_index[i];
+        is_combo_key |= process_combo_key(combo_get(entry->combo_index), keycode, record, entry->combo_index, entry->key_index, entry->key_count);
+    }
+    return is_combo_key;
+}
+#endif
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
     bool is_combo_key          = false;
     bool no_combo_keys_pressed = true;
@@ -564,10 +676,20 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_SIZE
+    if (!combo_index_built) {
+        combo_index_build();
+    }
+    if (!combo_index_overflowed) {
+        is_combo_key = process_indexed_combos(keycode, record);
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -575,10 +697,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_STRICT_TIMER
         if (!timer) {
             // timer is set only on the first key
-            timer = timer_read();
+            timer = record->event.time;
         }
 #    else
-        timer = timer_read();
+        timer = record->event.time;
 #    endif
 #endif
 
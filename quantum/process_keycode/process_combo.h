@@ -81,3 +81,7 @@ void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+#ifdef COMBO_INDEX_SIZE
+void combo_index_invalidate(void);
+#endif
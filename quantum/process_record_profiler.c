@@ -0,0 +1,139 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "process_record_profiler.h"
+#include "profiler.h"
+#include "quantum.h"
+
+typedef struct {
+    timestamp_t max;
+    uint64_t    ticks;
+} process_record_profiler_times_t;
+
+// Only the first process_record_profiler_slot_count() are in use. The
+// processors' call and skip counts are kept by process_record_get_stats()
+static process_record_profiler_times_t process_record_profiler_times[PROCESS_RECORD_SLOT_STAGES + PROCESS_RECORD_PROFILER_MAX_STAGES];
+static uint32_t                        process_record_profiler_calls[PROCESS_RECORD_SLOT_STAGES];
+
+// clang-format off
+static const char *const process_record_profiler_slot_names[PROCESS_RECORD_SLOT_STAGES] = {
+    [PROCESS_RECORD_SLOT_HANDLERS] = "handlers",
+    [PROCESS_RECORD_SLOT_KEY_LOCK] = "key_lock",
+    [PROCESS_RECORD_SLOT_USER]     = "user",
+};
+// clang-format on
+
+uint8_t process_record_profiler_slot_count(void) {
+    return PROCESS_RECORD_SLOT_STAGES + process_record_stage_count();
+}
+
+void process_record_profiler_reset(void) {
+    memset(process_record_profiler_times, 0, process_record_profiler_slot_count() * sizeof(process_record_profiler_times_t));
+    memset(process_record_profiler_calls, 0, sizeof(process_record_profiler_calls));
+    process_record_stats_reset();
+}
+
+void process_record_profiler_record(uint8_t slot, timestamp_t elapsed) {
+    if (slot >= process_record_profiler_slot_count()) {
+        return;
+    }
+
+    process_record_profiler_times_t *times = &process_record_profiler_times[slot];
+    if (elapsed > times->max) {
+        times->max = elapsed;
+    }
+    times->ticks += elapsed;
+    if (slot < PROCESS_RECORD_SLOT_STAGES) {
+        process_record_profiler_calls[slot]++;
+    }
+}
+
+const char *process_record_profiler_get_slot_name(uint8_t slot) {
+    if (slot < PROCESS_RECORD_SLOT_STAGES) {
+        return process_record_profiler_slot_names[slot];
+    }
+    return process_record_stage_name(slot - PROCESS_RECORD_SLOT_STAGES);
+}
+
+process_record_profiler_stats_t process_record_profiler_get_stats(uint8_t slot) {
+    process_record_profiler_stats_t stats = {0};
+    if (slot >= process_record_profiler_slot_count()) {
+        return stats;
+    }
+
+    if (slot < PROCESS_RECORD_SLOT_STAGES) {
+        stats.calls = process_record_profiler_calls[slot];
+    } else {
+        const process_record_stats_t *counts = process_record_get_stats(slot - PROCESS_RECORD_SLOT_STAGES);
+        stats.calls                          = counts->calls;
+        stats.skips                          = counts->skips;
+    }
+    stats.max   = process_record_profiler_times[slot].max;
+    stats.ticks = process_record_profiler_times[slot].ticks;
+    return stats;
+}
+
+void process_record_profiler_print(void) {
+    dprintf("process_record profiler: %lu ticks/s\n", (uint32_t)TIMESTAMP_FREQUENCY);
+    for (uint8_t slot = 0; slot < process_record_profiler_slot_count(); slot++) {
+        const process_record_profiler_stats_t stats = process_record_profiler_get_stats(slot);
+        if (stats.calls == 0 && stats.skips == 0) {
+            continue;
+        }
+        dprintf("%-20s calls=%lu skipped=%lu mean=%lu max=%lu\n", process_record_profiler_get_slot_name(slot), stats.calls, stats.skips, stats.calls ? (uint32_t)(stats.ticks / stats.calls) : 0, stats.max);
+    }
+}
+
+void process_record_profiler_task(void) {
+    static uint32_t last_print = 0;
+    profiler_print_every(&last_print, PROCESS_RECORD_PROFILER_PRINT_INTERVAL, process_record_profiler_print);
+}
+
+bool process_record_profiler_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, profiler_command, slot, payload... ]
+    if (!profiler_raw_hid_is_for(data, length, PROCESS_RECORD_PROFILER_RAW_HID_COMMAND_ID)) {
+        return false;
+    }
+
+    uint8_t *command = &data[1];
+    uint8_t  slot    = data[2];
+    uint8_t *payload = &data[3];
+    uint8_t  space   = length - 3;
+
+    switch (*command) {
+        case process_record_profiler_raw_hid_get_slot_count: {
+            data[2] = process_record_profiler_slot_count();
+            break;
+        }
+        case process_record_profiler_raw_hid_get_slot_name: {
+            const char *name = process_record_profiler_get_slot_name(slot);
+            profiler_raw_hid_pack_name(payload, space, name);
+            break;
+        }
+        case process_record_profiler_raw_hid_get_stats: {
+            // payload = [ frequency, calls, skips, max, ticks (64 bits) ], little endian
+            if (slot >= process_record_profiler_slot_count() || space < 24) {
+                *command = PROFILER_RAW_HID_ERROR;
+                break;
+            }
+            const process_record_profiler_stats_t stats = process_record_profiler_get_stats(slot);
+            profiler_pack_u32(&payload[0], TIMESTAMP_FREQUENCY);
+            profiler_pack_u32(&payload[4], stats.calls);
+            profiler_pack_u32(&payload[8], stats.skips);
+            profiler_pack_u32(&payload[12], stats.max);
+            profiler_pack_u32(&payload[16], (uint32_t)stats.ticks);
+            profiler_pack_u32(&payload[20], (uint32_t)(stats.ticks >> 32));
+            break;
+        }
+        case process_record_profiler_raw_hid_reset: {
+            process_record_profiler_reset();
+            break;
+        }
+        default: {
+            *command = PROFILER_RAW_HID_ERROR;
+            break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,84 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timestamp.h"
+
+/*
+    Keycode processor profiler.
+
+    Times each processor run by process_record_quantum(), plus key lock,
+    process_record_user() and the processor chain as a whole, accumulating
+    call counts and total timestamp ticks (see TIMESTAMP_FREQUENCY) per slot.
+    Events a processor is skipped for, because the keycode is outside its
+    range, are counted separately. The processors' call and skip counts are
+    those of PROCESS_RECORD_STATS, which the profiler turns on.
+
+    The "kb" slot includes the time spent in process_record_user(). The "user"
+    slot is only filled in by the default process_record_kb(); keyboards that
+    implement their own have their user time counted under "kb" alone.
+*/
+
+#if defined(PROCESS_RECORD_PROFILER_ENABLE) && !defined(PROCESS_RECORD_STATS)
+#    define PROCESS_RECORD_STATS
+#endif
+
+#ifndef PROCESS_RECORD_PROFILER_PRINT_INTERVAL
+#    define PROCESS_RECORD_PROFILER_PRINT_INTERVAL 10000
+#endif
+
+// Room for this many keycode processors; quantum.c fails to build if more
+// are enabled
+#ifndef PROCESS_RECORD_PROFILER_MAX_STAGES
+#    define PROCESS_RECORD_PROFILER_MAX_STAGES 32
+#endif
+
+#ifndef PROCESS_RECORD_PROFILER_RAW_HID_COMMAND_ID
+#    define PROCESS_RECORD_PROFILER_RAW_HID_COMMAND_ID 0xF2
+#endif
+
+enum {
+    PROCESS_RECORD_SLOT_HANDLERS, // key lock and every processor, per event
+    PROCESS_RECORD_SLOT_KEY_LOCK,
+    PROCESS_RECORD_SLOT_USER,
+    PROCESS_RECORD_SLOT_STAGES, // followed by one slot per processor
+};
+
+typedef struct {
+    uint32_t    calls;
+    uint32_t    skips; // always 0 for the slots before PROCESS_RECORD_SLOT_STAGES
+    timestamp_t max;
+    uint64_t    ticks;
+} process_record_profiler_stats_t;
+
+enum process_record_profiler_raw_hid_command {
+    process_record_profiler_raw_hid_get_slot_count = 0x01,
+    process_record_profiler_raw_hid_get_slot_name  = 0x02,
+    process_record_profiler_raw_hid_get_stats      = 0x03,
+    process_record_profiler_raw_hid_reset          = 0x04,
+};
+
+void                            process_record_profiler_reset(void);
+void                            process_record_profiler_record(uint8_t slot, timestamp_t elapsed);
+uint8_t                         process_record_profiler_slot_count(void);
+const char                     *process_record_profiler_get_slot_name(uint8_t slot);
+process_record_profiler_stats_t process_record_profiler_get_stats(uint8_t slot);
+void                            process_record_profiler_print(void);
+void                            process_record_profiler_task(void);
+bool                            process_record_profiler_raw_hid_receive(uint8_t *data, uint8_t length);
+
+static inline timestamp_t process_record_profiler_begin(void) {
+#ifdef PROCESS_RECORD_PROFILER_ENABLE
+    return timestamp_read();
+#else
+    return 0;
+#endif
+}
+
+static inline void process_record_profiler_end(uint8_t slot, timestamp_t start) {
+#ifdef PROCESS_RECORD_PROFILER_ENABLE
+    process_record_profiler_record(slot, TIMESTAMP_DIFF(timestamp_read(), start));
+#endif
+}
@@ -0,0 +1,178 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "profiler.h"
+#include "timer.h"
+#include "debug.h"
+#include "util.h"
+
+static profiler_stats_t profiler_stats[PROFILER_SLOT_COUNT];
+static timestamp_t      profiler_start[PROFILER_SLOT_COUNT];
+
+// clang-format off
+static const char *const profiler_slot_names[PROFILER_SLOT_USER] = {
+    [PROFILER_SLOT_KEYBOARD_TASK]        = "keyboard_task",
+    [PROFILER_SLOT_MATRIX_TASK]          = "matrix_task",
+    [PROFILER_SLOT_QUANTUM_TASK]         = "quantum_task",
+    [PROFILER_SLOT_RGB_MATRIX_TASK]      = "rgb_matrix_task",
+    [PROFILER_SLOT_LED_MATRIX_TASK]      = "led_matrix_task",
+    [PROFILER_SLOT_OLED_TASK]            = "oled_task",
+    [PROFILER_SLOT_POINTING_DEVICE_TASK] = "pointing_device_task",
+    [PROFILER_SLOT_SPLIT_TRANSACTIONS]   = "split_transactions",
+};
+// clang-format on
+
+void profiler_reset(void) {
+    memset(profiler_stats, 0, sizeof(profiler_stats));
+}
+
+void profiler_begin(uint8_t slot) {
+    if (slot < PROFILER_SLOT_COUNT) {
+        profiler_start[slot] = timestamp_read();
+    }
+}
+
+void profiler_end(uint8_t slot) {
+    if (slot < PROFILER_SLOT_COUNT) {
+        profiler_record(slot, TIMESTAMP_DIFF(timestamp_read(), profiler_start[slot]));
+    }
+}
+
+static inline uint8_t profiler_histogram_bucket(timestamp_t elapsed) {
+    uint8_t bucket = 0;
+    while (elapsed) {
+        elapsed >>= 1;
+        bucket++;
+    }
+    return MIN(bucket, PROFILER_HISTOGRAM_BUCKETS - 1);
+}
+
+void profiler_record(uint8_t slot, timestamp_t elapsed) {
+    if (slot >= PROFILER_SLOT_COUNT) {
+        return;
+    }
+
+    profiler_stats_t *stats = &profiler_stats[slot];
+    if (stats->count == 0 || elapsed < stats->min) {
+        stats->min = elapsed;
+    }
+    if (elapsed > stats->max) {
+        stats->max = elapsed;
+    }
+    stats->total += elapsed;
+    stats->count++;
+
+    uint16_t *bucket = &stats->histogram[profiler_histogram_bucket(elapsed)];
+    if (*bucket < UINT16_MAX) {
+        (*bucket)++;
+    }
+}
+
+const profiler_stats_t *profiler_get_stats(uint8_t slot) {
+    return slot < PROFILER_SLOT_COUNT ? &profiler_stats[slot] : NULL;
+}
+
+uint32_t profiler_get_mean(uint8_t slot) {
+    if (slot >= PROFILER_SLOT_COUNT || profiler_stats[slot].count == 0) {
+        return 0;
+    }
+    return (uint32_t)(profiler_stats[slot].total / profiler_stats[slot].count);
+}
+
+__attribute__((weak)) const char *profiler_slot_name_user(uint8_t user_slot) {
+    return NULL;
+}
+
+const char *profiler_get_slot_name(uint8_t slot) {
+    if (slot < PROFILER_SLOT_USER) {
+        return profiler_slot_names[slot];
+    }
+    if (slot < PROFILER_SLOT_COUNT) {
+        const char *name = profiler_slot_name_user(slot - PROFILER_SLOT_USER);
+        return name ? name : "user";
+    }
+    return NULL;
+}
+
+void profiler_print(void) {
+    dprintf("profiler: %lu ticks/s\n", (uint32_t)TIMESTAMP_FREQUENCY);
+    for (uint8_t slot = 0; slot < PROFILER_SLOT_COUNT; slot++) {
+        const profiler_stats_t *stats = &profiler_stats[slot];
+        if (stats->count == 0) {
+            continue;
+        }
+        dprintf("%-20s n=%lu min=%lu mean=%lu max=%lu\n", profiler_get_slot_name(slot), stats->count, stats->min, profiler_get_mean(slot), stats->max);
+        dprint("  log2 histogram:");
+        for (uint8_t bucket = 0; bucket < PROFILER_HISTOGRAM_BUCKETS; bucket++) {
+            dprintf(" %u", stats->histogram[bucket]);
+        }
+        dprint("\n");
+    }
+}
+
+void profiler_task(void) {
+    static uint32_t last_print = 0;
+    profiler_print_every(&last_print, PROFILER_PRINT_INTERVAL, profiler_print);
+}
+
+bool profiler_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, profiler_command, slot, payload... ]
+    if (!profiler_raw_hid_is_for(data, length, PROFILER_RAW_HID_COMMAND_ID)) {
+        return false;
+    }
+
+    uint8_t *command = &data[1];
+    uint8_t  slot    = data[2];
+    uint8_t *payload = &data[3];
+    uint8_t  space   = length - 3;
+
+    switch (*command) {
+        case profiler_raw_hid_get_slot_count: {
+            data[2] = PROFILER_SLOT_COUNT;
+            break;
+        }
+        case profiler_raw_hid_get_slot_name: {
+            const char *name = profiler_get_slot_name(slot);
+            profiler_raw_hid_pack_name(payload, space, name);
+            break;
+        }
+        case profiler_raw_hid_get_stats: {
+            // payload = [ frequency, count, min, max, mean ], little endian
+            if (slot >= PROFILER_SLOT_COUNT || space < 20) {
+                *command = PROFILER_RAW_HID_ERROR;
+                break;
+            }
+            profiler_pack_u32(&payload[0], TIMESTAMP_FREQUENCY);
+            profiler_pack_u32(&payload[4], profiler_stats[slot].count);
+            profiler_pack_u32(&payload[8], profiler_stats[slot].min);
+            profiler_pack_u32(&payload[12], profiler_stats[slot].max);
+            profiler_pack_u32(&payload[16], profiler_get_mean(slot));
+            break;
+        }
+        case profiler_raw_hid_get_histogram: {
+            // payload = [ first bucket, bucket count, buckets... ], little endian
+            if (slot >= PROFILER_SLOT_COUNT || space < 2) {
+                *command = PROFILER_RAW_HID_ERROR;
+                break;
+            }
+            uint8_t first = payload[0];
+            uint8_t count = 0;
+            for (uint8_t bucket = first; bucket < PROFILER_HISTOGRAM_BUCKETS && 2 + (count + 1) * 2 <= space; bucket++, count++) {
+                payload[2 + count * 2]     = profiler_stats[slot].histogram[bucket] & 0xFF;
+                payload[2 + count * 2 + 1] = profiler_stats[slot].histogram[bucket] >> 8;
+            }
+            payload[1] = count;
+            break;
+        }
+        case profiler_raw_hid_reset: {
+            profiler_reset();
+            break;
+        }
+        default: {
+            *command = PROFILER_RAW_HID_ERROR;
+            break;
+        }
+    }
+    return true;
+}
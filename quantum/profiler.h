@@ -0,0 +1,140 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "timer.h"
+#include "timestamp.h"
+
+/*
+    Main loop profiler.
+
+    Each slot accumulates statistics for a region of code, measured in
+    timestamp ticks (see TIMESTAMP_FREQUENCY). The core tasks are wrapped
+    automatically when PROFILER_ENABLE is set; keymaps may reserve extra slots
+    with PROFILER_USER_SLOT_COUNT and wrap their own code:
+
+        PROFILE_SLOT(PROFILER_SLOT_USER + 0, my_expensive_function());
+
+    or, where the region does not fit a single statement:
+
+        PROFILER_BEGIN(PROFILER_SLOT_USER + 0);
+        ...
+        PROFILER_END(PROFILER_SLOT_USER + 0);
+
+    The macros compile to nothing when the profiler is disabled.
+*/
+
+#ifndef PROFILER_USER_SLOT_COUNT
+#    define PROFILER_USER_SLOT_COUNT 0
+#endif
+
+#ifndef PROFILER_HISTOGRAM_BUCKETS
+#    define PROFILER_HISTOGRAM_BUCKETS 24
+#endif
+
+#ifndef PROFILER_PRINT_INTERVAL
+#    define PROFILER_PRINT_INTERVAL 10000
+#endif
+
+#ifndef PROFILER_RAW_HID_COMMAND_ID
+#    define PROFILER_RAW_HID_COMMAND_ID 0xF0
+#endif
+
+typedef enum {
+    PROFILER_SLOT_KEYBOARD_TASK,
+    PROFILER_SLOT_MATRIX_TASK,
+    PROFILER_SLOT_QUANTUM_TASK,
+    PROFILER_SLOT_RGB_MATRIX_TASK,
+    PROFILER_SLOT_LED_MATRIX_TASK,
+    PROFILER_SLOT_OLED_TASK,
+    PROFILER_SLOT_POINTING_DEVICE_TASK,
+    PROFILER_SLOT_SPLIT_TRANSACTIONS,
+    PROFILER_SLOT_USER,
+    PROFILER_SLOT_COUNT = PROFILER_SLOT_USER + PROFILER_USER_SLOT_COUNT,
+} profiler_slot_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    // Bucket n counts samples needing n bits, i.e. in [2^(n-1), 2^n)
+    uint16_t histogram[PROFILER_HISTOGRAM_BUCKETS];
+} profiler_stats_t;
+
+enum profiler_raw_hid_command {
+    profiler_raw_hid_get_slot_count = 0x01,
+    profiler_raw_hid_get_slot_name  = 0x02,
+    profiler_raw_hid_get_stats      = 0x03,
+    profiler_raw_hid_get_histogram  = 0x04,
+    profiler_raw_hid_reset          = 0x05,
+};
+
+void                    profiler_reset(void);
+void                    profiler_begin(uint8_t slot);
+void                    profiler_end(uint8_t slot);
+void                    profiler_record(uint8_t slot, timestamp_t elapsed);
+const profiler_stats_t *profiler_get_stats(uint8_t slot);
+uint32_t                profiler_get_mean(uint8_t slot);
+const char             *profiler_get_slot_name(uint8_t slot);
+const char             *profiler_slot_name_user(uint8_t user_slot);
+void                    profiler_print(void);
+void                    profiler_task(void);
+bool                    profiler_raw_hid_receive(uint8_t *data, uint8_t length);
+
+/*
+    Reporting helpers, shared with the latency tracer and the keycode
+    processor profiler.
+
+    Their raw HID packets are laid out as [ command_id, command, index,
+    payload... ]; unknown or invalid commands are answered with the command
+    byte set to PROFILER_RAW_HID_ERROR.
+*/
+
+#define PROFILER_RAW_HID_ERROR 0xFF
+
+/** Calls print() every interval milliseconds, tracking time in *last_print. */
+static inline void profiler_print_every(uint32_t *last_print, uint32_t interval, void (*print)(void)) {
+    if (interval > 0 && timer_elapsed32(*last_print) >= interval) {
+        *last_print = timer_read32();
+        print();
+    }
+}
+
+static inline void profiler_pack_u32(uint8_t *data, uint32_t value) {
+    data[0] = value & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = (value >> 16) & 0xFF;
+    data[3] = (value >> 24) & 0xFF;
+}
+
+/** Whether a raw HID packet is long enough and addressed to command_id. */
+static inline bool profiler_raw_hid_is_for(const uint8_t *data, uint8_t length, uint8_t command_id) {
+    return length >= 3 && data[0] == command_id;
+}
+
+/** Fills the payload with a NUL terminated, zero padded name. */
+static inline void profiler_raw_hid_pack_name(uint8_t *payload, uint8_t space, const char *name) {
+    memset(payload, 0, space);
+    if (name) {
+        strncpy((char *)payload, name, space - 1);
+    }
+}
+
+#ifdef PROFILER_ENABLE
+#    define PROFILER_BEGIN(slot) profiler_begin(slot)
+#    define PROFILER_END(slot) profiler_end(slot)
+#else
+#    define PROFILER_BEGIN(slot)
+#    define PROFILER_END(slot)
+#endif
+
+#define PROFILE_SLOT(slot, call) \
+    do {                         \
+        PROFILER_BEGIN(slot);    \
+        call;                    \
+        PROFILER_END(slot);      \
+    } while (0)
@@ -68,6 +68,10 @@
 #    include "process_unicode_common.h"
 #endif
 
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+#    include "eeprom_write_behind.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -159,7 +163,10 @@ __attribute__((weak)) bool process_action_kb(keyrecord_t *record) {
 }
 
 __attribute__((weak)) bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
-    return process_record_user(keycode, record);
+    const timestamp_t start  = process_record_profiler_begin();
+    const bool        result = process_record_user(keycode, record);
+    process_record_profiler_end(PROCESS_RECORD_SLOT_USER, start);
+    return result;
 }
 
 __attribute__((weak)) bool process_record_user(uint16_t keycode, keyrecord_t *record) {
@@ -174,6 +181,12 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_flush();
+#endif
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_sync();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -226,18 +239,16 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
     /* TODO: Use store_or_get_action() or a similar function. */
     if (!disable_action_cache) {
-        uint8_t layer;
-
         if (event.pressed && update_layer_cache) {
-            layer = layer_switch_get_layer(event.key);
+            uint16_t keycode;
+            uint8_t  layer = layer_switch_resolve(event.key, &keycode);
             update_source_layers_cache(event.key, layer);
-        } else {
-            layer = read_source_layers_cache(event.key);
+            return keycode;
         }
-        return keymap_key_to_keycode(layer, event.key);
+        return keymap_key_to_keycode(read_source_layers_cache(event.key), event.key);
     } else
 #endif
-        return keymap_key_to_keycode(layer_switch_get_layer(event.key), event.key);
+        return layer_switch_get_keycode(event.key);
 }
 
 /* Get keycode, and then process pre tapping functionality */
@@ -256,138 +267,260 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
-/* Core keycode function, hands off handling to other functions,
-    then processes internal quantum keycodes, and then processes
-    ACTIONs.                                                      */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
+typedef bool (*process_record_handler_t)(uint16_t keycode, keyrecord_t *record);
 
-    // This is how you use actions here
-    // if (keycode == QK_LEADER) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
+enum {
+    PROCESS_EVENT_PRESS   = 1 << 0,
+    PROCESS_EVENT_RELEASE = 1 << 1,
+    PROCESS_EVENT_ANY     = PROCESS_EVENT_PRESS | PROCESS_EVENT_RELEASE,
+};
 
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
+typedef struct {
+    process_record_handler_t handler;
+    uint16_t                 first;
+    uint16_t                 last;
+    uint8_t                  events;
+#ifdef PROCESS_RECORD_STATS
+    const char *name;
 #endif
+} process_record_stage_t;
 
-#ifdef TAP_DANCE_ENABLE
-    if (preprocess_tap_dance(keycode, record)) {
-        // The tap dance might have updated the layer state, therefore the
-        // result of the keycode lookup might change.
-        keycode = get_record_keycode(record, true);
-    }
+#ifdef PROCESS_RECORD_STATS
+#    define PROCESS_RECORD_STAGE(name, handler, first, last, events) {handler, first, last, events, name}
+#else
+#    define PROCESS_RECORD_STAGE(name, handler, first, last, events) {handler, first, last, events}
 #endif
+#define PROCESS_RECORD_STAGE_ALL(name, handler) PROCESS_RECORD_STAGE(name, handler, 0, UINT16_MAX, PROCESS_EVENT_ANY)
 
-#ifdef RGBLIGHT_ENABLE
-    if (record->event.pressed) {
-        preprocess_rgblight();
-    }
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+static bool process_rgb_stage(uint16_t keycode, keyrecord_t *record) {
+    return process_rgb(keycode, record);
+}
 #endif
 
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
+#ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_stage(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
 #endif
 
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
+/* The processors run by process_record_quantum(), in order. Each is only
+ * called for keycodes in its range and for the event kinds it acts on; for
+ * anything else it would return true without side effects. Processors that
+ * record, react to or are interrupted by any key cover every keycode.
+ */
+// clang-format off
+static const process_record_stage_t process_record_stages[] PROGMEM = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_RECORD_STAGE_ALL("dynamic_macro", process_dynamic_macro),
 #endif
 #ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("last_key", process_last_key),
+    PROCESS_RECORD_STAGE_ALL("repeat_key", process_repeat_key),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("clicky", process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("haptic", process_haptic),
 #endif
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("via", process_record_via),
 #endif
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("auto_mouse", process_auto_mouse),
 #endif
-            process_record_kb(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("kb", process_record_kb),
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("secure", process_secure),
+#endif
+#ifdef CHORDS_ENABLE
+    PROCESS_RECORD_STAGE_ALL("chords", process_chords),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_RECORD_STAGE("sequencer", process_sequencer, QK_SEQUENCER, QK_SEQUENCER_MAX, PROCESS_EVENT_PRESS),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_RECORD_STAGE("midi", process_midi, QK_MIDI, QK_MIDI_MAX, PROCESS_EVENT_ANY),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_RECORD_STAGE("audio", process_audio, QK_AUDIO_ON, QK_AUDIO_VOICE_PREVIOUS, PROCESS_EVENT_PRESS),
 #endif
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_RECORD_STAGE("backlight", process_backlight, QK_BACKLIGHT_ON, QK_BACKLIGHT_TOGGLE_BREATHING, PROCESS_EVENT_PRESS),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_RECORD_STAGE("steno", process_steno, QK_STENO, QK_STENO_MAX, PROCESS_EVENT_ANY),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("music", process_music),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("caps_word", process_caps_word),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("key_override", process_key_override_stage),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("tap_dance", process_tap_dance),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+#    ifdef UCIS_ENABLE
+    PROCESS_RECORD_STAGE_ALL("unicode", process_unicode_common),
+#    else
+    PROCESS_RECORD_STAGE("unicode_mode", process_unicode_common, QK_UNICODE_MODE_NEXT, QK_UNICODE_MODE_EMACS, PROCESS_EVENT_PRESS),
+    PROCESS_RECORD_STAGE("unicode", process_unicode_common, QK_UNICODE, QK_UNICODE_MAX, PROCESS_EVENT_PRESS),
+#    endif
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("leader", process_leader),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("auto_shift", process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_RECORD_STAGE("dynamic_tapping_term", process_dynamic_tapping_term, QK_DYNAMIC_TAPPING_TERM_PRINT, QK_DYNAMIC_TAPPING_TERM_DOWN, PROCESS_EVENT_PRESS),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("space_cadet", process_space_cadet),
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_RECORD_STAGE("magic", process_magic, QK_MAGIC, QK_MAGIC_MAX, PROCESS_EVENT_PRESS),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_RECORD_STAGE("grave_esc", process_grave_esc, QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, PROCESS_EVENT_ANY),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+    PROCESS_RECORD_STAGE("rgb", process_rgb_stage, RGB_TOG, RGB_MODE_TWINKLE, PROCESS_EVENT_ANY),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_RECORD_STAGE("joystick", process_joystick, QK_JOYSTICK, QK_JOYSTICK_MAX, PROCESS_EVENT_ANY),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_RECORD_STAGE("programmable_button", process_programmable_button, QK_PROGRAMMABLE_BUTTON, QK_PROGRAMMABLE_BUTTON_MAX, PROCESS_EVENT_ANY),
 #endif
 #ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
+    PROCESS_RECORD_STAGE_ALL("autocorrect", process_autocorrect),
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    PROCESS_RECORD_STAGE("tri_layer", process_tri_layer, QK_TRI_LAYER_LOWER, QK_TRI_LAYER_UPPER, PROCESS_EVENT_ANY),
+#endif
+};
+// clang-format on
+
+#ifdef PROCESS_RECORD_PROFILER_ENABLE
+_Static_assert(ARRAY_SIZE(process_record_stages) <= PROCESS_RECORD_PROFILER_MAX_STAGES, "Raise PROCESS_RECORD_PROFILER_MAX_STAGES to profile every keycode processor");
+#endif
+
+#ifdef PROCESS_RECORD_STATS
+static process_record_stats_t process_record_stats[ARRAY_SIZE(process_record_stages)];
+
+#    define PROCESS_RECORD_STATS_COUNT(stage, counter) process_record_stats[stage].counter++
+#else
+#    define PROCESS_RECORD_STATS_COUNT(stage, counter)
+#endif
+
+uint8_t process_record_stage_count(void) {
+    return ARRAY_SIZE(process_record_stages);
+}
+
+#ifdef PROCESS_RECORD_STATS
+const char *process_record_stage_name(uint8_t stage) {
+    return stage < ARRAY_SIZE(process_record_stages) ? (const char *)pgm_read_ptr(&process_record_stages[stage].name) : NULL;
+}
+
+const process_record_stats_t *process_record_get_stats(uint8_t stage) {
+    return stage < ARRAY_SIZE(process_record_stages) ? &process_record_stats[stage] : NULL;
+}
+
+void process_record_stats_reset(void) {
+    memset(process_record_stats, 0, sizeof(process_record_stats));
+}
+
+void process_record_stats_print(void) {
+    for (uint8_t stage = 0; stage < ARRAY_SIZE(process_record_stages); stage++) {
+        dprintf("process %-20s calls=%lu skipped=%lu\n", process_record_stage_name(stage), process_record_stats[stage].calls, process_record_stats[stage].skips);
+    }
+}
+#endif
+
+static bool process_record_handlers(uint16_t *keycode, keyrecord_t *record) {
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    const timestamp_t key_lock_start    = process_record_profiler_begin();
+    const bool        key_lock_continue = process_key_lock(keycode, record);
+    process_record_profiler_end(PROCESS_RECORD_SLOT_KEY_LOCK, key_lock_start);
+    if (!key_lock_continue) {
+        return false;
+    }
+#endif
+
+    const uint8_t event_kind = record->event.pressed ? PROCESS_EVENT_PRESS : PROCESS_EVENT_RELEASE;
+    for (uint8_t i = 0; i < ARRAY_SIZE(process_record_stages); i++) {
+        const process_record_stage_t *stage = &process_record_stages[i];
+        if (*keycode < pgm_read_word(&stage->first) || *keycode > pgm_read_word(&stage->last) || !(pgm_read_byte(&stage->events) & event_kind)) {
+            PROCESS_RECORD_STATS_COUNT(i, skips);
+            continue;
+        }
+        PROCESS_RECORD_STATS_COUNT(i, calls);
+
+        const timestamp_t start        = process_record_profiler_begin();
+        const bool        continue_run = ((process_record_handler_t)pgm_read_ptr(&stage->handler))(*keycode, record);
+        process_record_profiler_end(PROCESS_RECORD_SLOT_STAGES + i, start);
+        if (!continue_run) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Core keycode function, hands off handling to other functions,
+    then processes internal quantum keycodes, and then processes
+    ACTIONs.                                                      */
+bool process_record_quantum(keyrecord_t *record) {
+    LATENCY_TRACE_STAMP(LATENCY_STAGE_PROCESS_RECORD, record->event);
+
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == QK_LEADER) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
+        return false;
+    }
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+    if (preprocess_tap_dance(keycode, record)) {
+        // The tap dance might have updated the layer state, therefore the
+        // result of the keycode lookup might change.
+        keycode = get_record_keycode(record, true);
+    }
 #endif
-            true)) {
+
+#ifdef RGBLIGHT_ENABLE
+    if (record->event.pressed) {
+        preprocess_rgblight();
+    }
+#endif
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+    const timestamp_t handlers_start    = process_record_profiler_begin();
+    const bool        handlers_continue = process_record_handlers(&keycode, record);
+    process_record_profiler_end(PROCESS_RECORD_SLOT_HANDLERS, handlers_start);
+    if (!handlers_continue) {
         return false;
     }
 
@@ -504,6 +637,12 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_flush();
+#endif
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_sync();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
@@ -53,6 +53,10 @@
 #include "print.h"
 #include "debug.h"
 #include "suspend.h"
+#include "profiler.h"
+#include "process_record_profiler.h"
+#include "latency_trace.h"
+#include "task_scheduler.h"
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -90,6 +94,10 @@ extern layer_state_t layer_state;
 #    endif
 #endif
 
+#ifdef CHORDS_ENABLE
+#    include "process_chords.h"
+#endif
+
 #ifdef STENO_ENABLE
 #    include "process_steno.h"
 #endif
@@ -259,6 +267,19 @@ bool     process_record_user(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_kb(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_user(uint16_t keycode, keyrecord_t *record);
 
+typedef struct {
+    uint32_t calls;
+    uint32_t skips; // events outside the processor's keycode range or event kind
+} process_record_stats_t;
+
+uint8_t process_record_stage_count(void);
+#ifdef PROCESS_RECORD_STATS
+const char                   *process_record_stage_name(uint8_t stage);
+const process_record_stats_t *process_record_get_stats(uint8_t stage);
+void                          process_record_stats_reset(void);
+void                          process_record_stats_print(void);
+#endif
+
 void reset_keyboard(void);
 void soft_reset_keyboard(void);
 
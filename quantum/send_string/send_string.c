@@ -22,7 +22,13 @@
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
+#include "action_util.h"
+#include "host.h"
+#include "keycode_config.h"
 #include "wait.h"
+#ifdef SEND_STRING_ASYNC_QUEUE_SIZE
+#    include "timer.h"
+#endif
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -146,49 +152,101 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
+enum send_string_step_type {
+    SEND_STRING_STEP_END,
+    SEND_STRING_STEP_CHAR,
+    SEND_STRING_STEP_TAP,
+    SEND_STRING_STEP_DOWN,
+    SEND_STRING_STEP_UP,
+    SEND_STRING_STEP_DELAY,
+    SEND_STRING_STEP_NONE, // unknown Send String keycode, ignored
+};
+
+typedef struct {
+    uint8_t  type;
+    char     ascii_code; // SEND_STRING_STEP_CHAR
+    uint8_t  keycode;    // SEND_STRING_STEP_TAP, _DOWN and _UP
+    uint32_t ms;         // SEND_STRING_STEP_DELAY
+} send_string_step_t;
+
+static char send_string_read(const char *string, bool progmem) {
+    return progmem ? pgm_read_byte(string) : *string;
+}
+
+// Parses the character or Send String keycode at the start of string into
+// step, returning where the next one starts
+static const char *send_string_parse_step(const char *string, bool progmem, send_string_step_t *step) {
+    char ascii_code = send_string_read(string, progmem);
+    if (!ascii_code) {
+        step->type = SEND_STRING_STEP_END;
+        return string;
+    }
+    if (ascii_code != SS_QMK_PREFIX) {
+        step->type       = SEND_STRING_STEP_CHAR;
+        step->ascii_code = ascii_code;
+        return string + 1;
+    }
+
+    ascii_code = send_string_read(++string, progmem);
+    switch (ascii_code) {
+        case SS_TAP_CODE:
+            step->type = SEND_STRING_STEP_TAP;
+            break;
+        case SS_DOWN_CODE:
+            step->type = SEND_STRING_STEP_DOWN;
+            break;
+        case SS_UP_CODE:
+            step->type = SEND_STRING_STEP_UP;
+            break;
+        case SS_DELAY_CODE: {
+            // The digits are followed by a terminator, skipped along with them
+            uint8_t digit = send_string_read(++string, progmem);
+            step->type    = SEND_STRING_STEP_DELAY;
+            step->ms      = 0;
+            while (isdigit(digit)) {
+                step->ms *= 10;
+                step->ms += digit - '0';
+                digit = send_string_read(++string, progmem);
+            }
+            return string + 1;
+        }
+        default:
+            step->type = SEND_STRING_STEP_NONE;
+            return string + 1;
+    }
+    step->keycode = send_string_read(++string, progmem);
+    return string + 1;
+}
+
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
 
 void send_string_with_delay(const char *string, uint8_t interval) {
+    send_string_step_t step;
     while (1) {
-        char ascii_code = *string;
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
-            ascii_code = *(++string);
-
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = *(++string);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = *(++string);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = *(++string);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int     ms      = 0;
-                uint8_t keycode = *(++string);
-
-                while (isdigit(keycode)) {
-                    ms *= 10;
-                    ms += keycode - '0';
-                    keycode = *(++string);
-                }
-
-                wait_ms(ms);
-            }
-
-            wait_ms(interval);
-        } else {
-            send_char_with_delay(ascii_code, interval);
+        string = send_string_parse_step(string, false, &step);
+        if (step.type == SEND_STRING_STEP_END) break;
+
+        switch (step.type) {
+            case SEND_STRING_STEP_CHAR:
+                send_char_with_delay(step.ascii_code, interval);
+                continue;
+            case SEND_STRING_STEP_TAP:
+                tap_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_DOWN:
+                register_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_UP:
+                unregister_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_DELAY:
+                wait_ms(step.ms);
+                break;
         }
 
-        ++string;
+        wait_ms(interval);
     }
 }
 
@@ -292,45 +350,330 @@ void tap_random_base64(void) {
     }
 }
 
+// Keys pressed at once by send_string_turbo(), at most
+#define TURBO_BATCH_SIZE 16
+
+typedef struct {
+    uint8_t keys[TURBO_BATCH_SIZE];
+    uint8_t count;
+    uint8_t mods;
+} turbo_batch_t;
+
+// Number of keys that still fit in the report alongside those already held
+static uint8_t turbo_batch_limit(void) {
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        return TURBO_BATCH_SIZE;
+    }
+#endif
+    uint8_t free = KEYBOARD_REPORT_KEYS - has_anykey();
+    return free < TURBO_BATCH_SIZE ? free : TURBO_BATCH_SIZE;
+}
+
+// Presses the batched keys in one report, and releases them in the next
+static void turbo_flush(turbo_batch_t *batch) {
+    if (!batch->count) {
+        return;
+    }
+
+    add_weak_mods(batch->mods);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        add_key(batch->keys[i]);
+    }
+    send_keyboard_report();
+    wait_ms(TAP_CODE_DELAY);
+
+    for (uint8_t i = 0; i < batch->count; i++) {
+        del_key(batch->keys[i]);
+    }
+    del_weak_mods(batch->mods);
+    send_keyboard_report();
+    wait_ms(TAP_CODE_DELAY);
+
+    batch->count = 0;
+}
+
+// Adds a character to the batch, or types it out straight away if it can't
+// share a report with other keys
+static void turbo_add_char(turbo_batch_t *batch, char ascii_code) {
+    uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    uint8_t mods    = (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code) ? MOD_BIT(KC_LEFT_SHIFT) : 0) | (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code) ? MOD_BIT(KC_RIGHT_ALT) : 0);
+
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') {
+        keycode = KC_NO;
+    }
+#endif
+    // A key that is already held would be released along with the batch,
+    // and a full report has no room for one
+    if (!keycode || PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code) || is_key_pressed(keycode) || !turbo_batch_limit()) {
+        turbo_flush(batch);
+        send_char(ascii_code);
+        return;
+    }
+
+    // Hosts may handle the keys of a report in keycode order, so only
+    // ascending keycodes are batched, which also keeps repeats apart
+    if (batch->count && (mods != batch->mods || keycode <= batch->keys[batch->count - 1] || batch->count >= turbo_batch_limit())) {
+        turbo_flush(batch);
+    }
+    batch->keys[batch->count++] = keycode;
+    batch->mods                 = mods;
+}
+
+static void turbo_send_string(const char *string, bool progmem) {
+    turbo_batch_t      batch = {.count = 0};
+    send_string_step_t step;
+
+    while (1) {
+        string = send_string_parse_step(string, progmem, &step);
+        if (step.type == SEND_STRING_STEP_END) break;
+        if (step.type == SEND_STRING_STEP_CHAR) {
+            turbo_add_char(&batch, step.ascii_code);
+            continue;
+        }
+
+        turbo_flush(&batch);
+        switch (step.type) {
+            case SEND_STRING_STEP_TAP:
+                tap_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_DOWN:
+                register_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_UP:
+                unregister_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_DELAY:
+                while (step.ms--)
+                    wait_ms(1);
+                break;
+        }
+    }
+
+    turbo_flush(&batch);
+}
+
+void send_string_turbo(const char *string) {
+    turbo_send_string(string, false);
+}
+
+#if defined(__AVR__)
+void send_string_turbo_P(const char *string) {
+    turbo_send_string(string, true);
+}
+#endif
+
+#ifdef SEND_STRING_ASYNC_QUEUE_SIZE
+#    if SEND_STRING_ASYNC_QUEUE_SIZE > 255
+#        error "SEND_STRING_ASYNC_QUEUE_SIZE must not be greater than 255"
+#    endif
+
+typedef struct {
+    const char *string;
+    bool        progmem;
+} async_string_t;
+
+typedef struct {
+    uint8_t keycode;
+    bool    pressed;
+} async_step_t;
+
+static async_string_t async_queue[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t        async_queue_head  = 0;
+static uint8_t        async_queue_count = 0;
+// Position in the string at the head of the queue, NULL until it is started
+static const char *async_position = NULL;
+
+// Key presses and releases making up the character being typed
+static async_step_t async_steps[8];
+static uint8_t      async_step       = 0;
+static uint8_t      async_step_count = 0;
+
+static uint16_t async_timer = 0;
+static uint16_t async_wait  = 0;
+
+// Basic keycodes held down by the queued strings, released on cancel
+static uint8_t async_held[32];
+
+static bool async_enqueue(const char *string, bool progmem) {
+    if (async_queue_count >= SEND_STRING_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+
+    async_string_t *entry = &async_queue[(async_queue_head + async_queue_count++) % SEND_STRING_ASYNC_QUEUE_SIZE];
+    entry->string         = string;
+    entry->progmem        = progmem;
+    return true;
+}
+
+bool send_string_async(const char *string) {
+    return async_enqueue(string, false);
+}
+
+#    if defined(__AVR__)
+bool send_string_async_P(const char *string) {
+    return async_enqueue(string, true);
+}
+#    endif
+
+bool send_string_async_is_active(void) {
+    return async_queue_count || async_step < async_step_count;
+}
+
+static void async_add_step(uint8_t keycode, bool pressed) {
+    async_steps[async_step_count].keycode = keycode;
+    async_steps[async_step_count].pressed = pressed;
+    async_step_count++;
+}
+
+// Drops the strings at the head of the queue that have been typed out
+static void async_skip_finished(void) {
+    while (async_queue_count) {
+        if (!async_position) {
+            async_position = async_queue[async_queue_head].string;
+        }
+        if (send_string_read(async_position, async_queue[async_queue_head].progmem)) {
+            break;
+        }
+        async_position   = NULL;
+        async_queue_head = (async_queue_head + 1) % SEND_STRING_ASYNC_QUEUE_SIZE;
+        async_queue_count--;
+    }
+}
+
+// Parses the next character or Send String keycode of the queue into steps,
+// the same ones send_string_with_delay() would type
+static bool async_load(void) {
+    async_skip_finished();
+    if (!async_queue_count) {
+        return false;
+    }
+
+    send_string_step_t step;
+    async_position   = send_string_parse_step(async_position, async_queue[async_queue_head].progmem, &step);
+    async_step       = 0;
+    async_step_count = 0;
+
+    switch (step.type) {
+        case SEND_STRING_STEP_TAP:
+            async_add_step(step.keycode, true);
+            async_add_step(step.keycode, false);
+            break;
+        case SEND_STRING_STEP_DOWN:
+            async_add_step(step.keycode, true);
+            break;
+        case SEND_STRING_STEP_UP:
+            async_add_step(step.keycode, false);
+            break;
+        case SEND_STRING_STEP_DELAY:
+            async_wait = step.ms;
+            break;
+        case SEND_STRING_STEP_CHAR: {
+            char ascii_code = step.ascii_code;
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+            if (ascii_code == '\a') { // BEL
+                PLAY_SONG(bell_song);
+                break;
+            }
+#    endif
+
+            uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+            bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+            bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+            bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+            if (is_shifted) async_add_step(KC_LEFT_SHIFT, true);
+            if (is_altgred) async_add_step(KC_RIGHT_ALT, true);
+            async_add_step(keycode, true);
+            async_add_step(keycode, false);
+            if (is_altgred) async_add_step(KC_RIGHT_ALT, false);
+            if (is_shifted) async_add_step(KC_LEFT_SHIFT, false);
+            if (is_dead) {
+                async_add_step(KC_SPACE, true);
+                async_add_step(KC_SPACE, false);
+            }
+            break;
+        }
+    }
+
+    async_skip_finished();
+    return true;
+}
+
+static void async_play(async_step_t step) {
+    if (step.pressed) {
+        async_held[step.keycode / 8] |= 1 << (step.keycode % 8);
+        register_code(step.keycode);
+    } else {
+        async_held[step.keycode / 8] &= ~(1 << (step.keycode % 8));
+        unregister_code(step.keycode);
+    }
+}
+
+void send_string_async_task(void) {
+    if (async_wait) {
+        if (timer_elapsed(async_timer) < async_wait) {
+            return;
+        }
+        async_wait = 0;
+    }
+
+    if (async_step >= async_step_count && !async_load()) {
+        return;
+    }
+
+    if (async_step < async_step_count) {
+        async_play(async_steps[async_step++]);
+        async_wait = TAP_CODE_DELAY;
+    }
+    async_timer = timer_read();
+}
+
+void send_string_async_cancel(void) {
+    async_queue_count = 0;
+    async_position    = NULL;
+    async_step        = 0;
+    async_step_count  = 0;
+    async_wait        = 0;
+
+    for (uint16_t keycode = 0; keycode < 256; keycode++) {
+        if (async_held[keycode / 8] & (1 << (keycode % 8))) {
+            async_play((async_step_t){.keycode = keycode, .pressed = false});
+        }
+    }
+}
+#endif
+
 #if defined(__AVR__)
 void send_string_P(const char *string) {
     send_string_with_delay_P(string, 0);
 }
 
 void send_string_with_delay_P(const char *string, uint8_t interval) {
+    send_string_step_t step;
     while (1) {
-        char ascii_code = pgm_read_byte(string);
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
-            ascii_code = pgm_read_byte(++string);
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = pgm_read_byte(++string);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = pgm_read_byte(++string);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = pgm_read_byte(++string);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int     ms      = 0;
-                uint8_t keycode = pgm_read_byte(++string);
-                while (isdigit(keycode)) {
-                    ms *= 10;
-                    ms += keycode - '0';
-                    keycode = pgm_read_byte(++string);
-                }
-                while (ms--)
+        string = send_string_parse_step(string, true, &step);
+        if (step.type == SEND_STRING_STEP_END) break;
+
+        switch (step.type) {
+            case SEND_STRING_STEP_CHAR:
+                send_char(step.ascii_code);
+                break;
+            case SEND_STRING_STEP_TAP:
+                tap_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_DOWN:
+                register_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_UP:
+                unregister_code(step.keycode);
+                break;
+            case SEND_STRING_STEP_DELAY:
+                while (step.ms--)
                     wait_ms(1);
-            }
-        } else {
-            send_char(ascii_code);
+                break;
         }
-        ++string;
         // interval
         {
             uint8_t ms = interval;
@@ -23,7 +23,10 @@
  * \{
  */
 
+#pragma once
+
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -147,6 +150,90 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
 #    define send_string_with_delay_P(string, interval) send_string_with_delay(string, interval)
 #endif
 
+/**
+ * \brief Type out a string of ASCII characters, pressing several keys per report where possible.
+ *
+ * Consecutive characters sharing the same modifiers are pressed together in one report and released in the next, as
+ * long as their keycodes are ascending, so the host sees them in order whether it handles the keys of a report by
+ * position or by keycode. Up to six keys are batched, or sixteen with NKRO.
+ *
+ * \param string The string to type out.
+ */
+void send_string_turbo(const char *string);
+
+#if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Type out a PROGMEM string of ASCII characters, pressing several keys per report where possible.
+ *
+ * On ARM devices, this function is simply an alias for send_string_turbo(string).
+ *
+ * \param string The string to type out.
+ */
+void send_string_turbo_P(const char *string);
+#else
+#    define send_string_turbo_P(string) send_string_turbo(string)
+#endif
+
+/**
+ * \brief Shortcut macro for send_string_turbo_P(PSTR(string)).
+ *
+ * On ARM devices, this define evaluates to send_string_turbo(string).
+ */
+#define SEND_STRING_TURBO(string) send_string_turbo_P(PSTR(string))
+
+#if defined(SEND_STRING_ASYNC_QUEUE_SIZE) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * The string is played back by send_string_async_task(), one key press or release at a time, so the keyboard keeps
+ * scanning and processing keys meanwhile. It is not copied, and must remain valid until it has been typed out.
+ *
+ * \param string The string to type out.
+ *
+ * \return false if the queue is full, in which case nothing is typed.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Stop typing out the queued strings, and release any key still held by them.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Check whether queued strings are still being typed out.
+ */
+bool send_string_async_is_active(void);
+
+/**
+ * \brief Type out the next key press or release of the queued strings, once the previous one is due.
+ *
+ * This is called from the main loop.
+ */
+void send_string_async_task(void);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async(string).
+ *
+ * \param string The string to type out.
+ *
+ * \return false if the queue is full, in which case nothing is typed.
+ */
+bool send_string_async_P(const char *string);
+#    else
+#        define send_string_async_P(string) send_string_async(string)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_P(PSTR(string)).
+ *
+ * On ARM devices, this define evaluates to send_string_async(string).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_P(PSTR(string))
+#endif
+
 /**
  * \brief Shortcut macro for send_string_with_delay_P(PSTR(string), 0).
  *
@@ -21,6 +21,7 @@
 #include "transport.h"
 #include "transaction_id_define.h"
 #include "atomic_util.h"
+#include "profiler.h"
 
 #ifdef USE_I2C
 
@@ -122,9 +123,11 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    return transactions_master(master_matrix, slave_matrix);
+    bool okay;
+    PROFILE_SLOT(PROFILER_SLOT_SPLIT_TRANSACTIONS, okay = transactions_master(master_matrix, slave_matrix));
+    return okay;
 }
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    transactions_slave(master_matrix, slave_matrix);
+    PROFILE_SLOT(PROFILER_SLOT_SPLIT_TRANSACTIONS, transactions_slave(master_matrix, slave_matrix));
 }
@@ -0,0 +1,166 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "task_scheduler.h"
+#include "timer.h"
+#include "debug.h"
+
+#define TASK_SCHEDULER_US_TO_TICKS(us) ((timestamp_t)(((uint64_t)(us) * (TIMESTAMP_FREQUENCY)) / 1000000))
+
+typedef struct {
+    task_schedule_t schedule;
+    timestamp_t     budget; // in ticks
+    timestamp_t     start;
+    uint32_t        last_run;
+    uint8_t         last_loop;
+} task_state_t;
+
+// clang-format off
+static const task_schedule_t default_schedules[SCHEDULED_TASK_COUNT] = {
+    [SCHEDULED_TASK_RGBLIGHT]        = {.priority = 2},
+    [SCHEDULED_TASK_LED_MATRIX]      = {.priority = 2},
+    [SCHEDULED_TASK_RGB_MATRIX]      = {.priority = 2},
+    [SCHEDULED_TASK_BACKLIGHT]       = {.priority = 3},
+    [SCHEDULED_TASK_OLED]            = {.priority = 1},
+    [SCHEDULED_TASK_ST7565]          = {.priority = 1},
+    [SCHEDULED_TASK_QUANTUM_PAINTER] = {.priority = 0},
+};
+
+static const char *const task_names[SCHEDULED_TASK_COUNT] = {
+    [SCHEDULED_TASK_RGBLIGHT]        = "rgblight",
+    [SCHEDULED_TASK_LED_MATRIX]      = "led_matrix",
+    [SCHEDULED_TASK_RGB_MATRIX]      = "rgb_matrix",
+    [SCHEDULED_TASK_BACKLIGHT]       = "backlight",
+    [SCHEDULED_TASK_OLED]            = "oled",
+    [SCHEDULED_TASK_ST7565]          = "st7565",
+    [SCHEDULED_TASK_QUANTUM_PAINTER] = "quantum_painter",
+};
+// clang-format on
+
+static task_state_t           task_states[SCHEDULED_TASK_COUNT];
+static task_scheduler_stats_t task_stats[SCHEDULED_TASK_COUNT];
+static timestamp_t            loop_budget;
+static timestamp_t            loop_start;
+static uint8_t                loop_count;
+static bool                   loop_started;
+static uint32_t               loop_overruns;
+
+__attribute__((weak)) task_schedule_t task_scheduler_get_schedule_user(scheduled_task_t task, task_schedule_t schedule) {
+    return schedule;
+}
+
+__attribute__((weak)) task_schedule_t task_scheduler_get_schedule_kb(scheduled_task_t task, task_schedule_t schedule) {
+    return task_scheduler_get_schedule_user(task, schedule);
+}
+
+void task_scheduler_init(void) {
+    memset(task_states, 0, sizeof(task_states));
+    memset(task_stats, 0, sizeof(task_stats));
+
+    const uint32_t now = timer_read32();
+    for (uint8_t task = 0; task < SCHEDULED_TASK_COUNT; task++) {
+        task_state_t *state = &task_states[task];
+        state->schedule     = task_scheduler_get_schedule_kb(task, default_schedules[task]);
+        state->budget       = TASK_SCHEDULER_US_TO_TICKS(state->schedule.budget);
+        state->last_run     = now;
+        state->last_loop    = UINT8_MAX;
+    }
+
+    loop_budget   = TASK_SCHEDULER_US_TO_TICKS(TASK_SCHEDULER_LOOP_BUDGET);
+    loop_count    = 0;
+    loop_started  = false;
+    loop_overruns = 0;
+}
+
+void task_scheduler_loop_begin(void) {
+    const timestamp_t now = timestamp_read();
+    if (loop_started && TIMESTAMP_DIFF(now, loop_start) > loop_budget) {
+        loop_overruns++;
+    }
+    loop_start   = now;
+    loop_started = true;
+    loop_count++;
+}
+
+static inline bool task_is_due(const task_state_t *state, uint32_t now) {
+    return TIMER_DIFF_32(now, state->last_run) >= state->schedule.period;
+}
+
+bool task_scheduler_task_begin(scheduled_task_t task) {
+    task_state_t  *state = &task_states[task];
+    const uint32_t now   = timer_read32();
+
+    if (!task_is_due(state, now)) {
+        return false;
+    }
+
+    // Tasks overdue by TASK_SCHEDULER_MAX_DEFER run regardless of the loop budget
+    if (TIMER_DIFF_32(now, state->last_run) - state->schedule.period < TASK_SCHEDULER_MAX_DEFER) {
+        // Leave room for higher priority tasks still waiting to run this loop
+        timestamp_t required = task_stats[task].cost;
+        for (uint8_t other = 0; other < SCHEDULED_TASK_COUNT; other++) {
+            const task_state_t *other_state = &task_states[other];
+            if (other_state->schedule.priority > state->schedule.priority && other_state->last_loop != loop_count && task_is_due(other_state, now)) {
+                required += task_stats[other].cost;
+            }
+        }
+
+        if (TIMESTAMP_DIFF(timestamp_read(), loop_start) + required > loop_budget) {
+            task_stats[task].deferrals++;
+            return false;
+        }
+    }
+
+    state->start = timestamp_read();
+    return true;
+}
+
+void task_scheduler_task_end(scheduled_task_t task) {
+    task_state_t           *state   = &task_states[task];
+    task_scheduler_stats_t *stats   = &task_stats[task];
+    const timestamp_t       elapsed = TIMESTAMP_DIFF(timestamp_read(), state->start);
+
+    // Exponential moving average, seeded with the first sample
+    stats->cost = stats->runs ? stats->cost - stats->cost / 8 + elapsed / 8 : elapsed;
+    stats->runs++;
+    if (state->budget && elapsed > state->budget) {
+        stats->overruns++;
+    }
+
+    state->last_run  = timer_read32();
+    state->last_loop = loop_count;
+}
+
+const char *task_scheduler_get_task_name(scheduled_task_t task) {
+    return task < SCHEDULED_TASK_COUNT ? task_names[task] : NULL;
+}
+
+uint32_t task_scheduler_loop_overruns(void) {
+    return loop_overruns;
+}
+
+const task_scheduler_stats_t *task_scheduler_get_stats(scheduled_task_t task) {
+    return task < SCHEDULED_TASK_COUNT ? &task_stats[task] : NULL;
+}
+
+void task_scheduler_print(void) {
+    dprintf("scheduler: %lu loop overruns\n", loop_overruns);
+    for (uint8_t task = 0; task < SCHEDULED_TASK_COUNT; task++) {
+        const task_scheduler_stats_t *stats = &task_stats[task];
+        if (stats->runs == 0 && stats->deferrals == 0) {
+            continue;
+        }
+        dprintf("%-16s runs=%lu deferred=%lu overruns=%lu cost=%luus\n", task_scheduler_get_task_name(task), stats->runs, stats->deferrals, stats->overruns, TIMESTAMP_TO_US(stats->cost));
+    }
+}
+
+void task_scheduler_task(void) {
+#if TASK_SCHEDULER_PRINT_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= TASK_SCHEDULER_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        task_scheduler_print();
+    }
+#endif
+}
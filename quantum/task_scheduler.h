@@ -0,0 +1,84 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timestamp.h"
+
+/*
+    Cooperative scheduler for the cosmetic main loop tasks.
+
+    Matrix scanning, key processing and report sending always run every loop.
+    Lighting and display tasks are instead gated by the scheduler: each has a
+    minimum period, a priority and an optional time budget. When the main loop
+    is running over TASK_SCHEDULER_LOOP_BUDGET, tasks whose expected cost would
+    not fit are deferred to a later loop, lowest priority first. A task is
+    never deferred for longer than TASK_SCHEDULER_MAX_DEFER milliseconds.
+*/
+
+#ifndef TASK_SCHEDULER_LOOP_BUDGET
+// Microseconds
+#    define TASK_SCHEDULER_LOOP_BUDGET 1000
+#endif
+
+#ifndef TASK_SCHEDULER_MAX_DEFER
+// Milliseconds
+#    define TASK_SCHEDULER_MAX_DEFER 50
+#endif
+
+#ifndef TASK_SCHEDULER_PRINT_INTERVAL
+#    define TASK_SCHEDULER_PRINT_INTERVAL 10000
+#endif
+
+typedef enum {
+    SCHEDULED_TASK_RGBLIGHT,
+    SCHEDULED_TASK_LED_MATRIX,
+    SCHEDULED_TASK_RGB_MATRIX,
+    SCHEDULED_TASK_BACKLIGHT,
+    SCHEDULED_TASK_OLED,
+    SCHEDULED_TASK_ST7565,
+    SCHEDULED_TASK_QUANTUM_PAINTER,
+    SCHEDULED_TASK_COUNT,
+} scheduled_task_t;
+
+typedef struct {
+    uint16_t period;   // minimum milliseconds between runs, 0 to run every loop
+    uint16_t budget;   // microseconds per run before it counts as an overrun, 0 for none
+    uint8_t  priority; // higher priorities are deferred last
+} task_schedule_t;
+
+typedef struct {
+    uint32_t    runs;
+    uint32_t    deferrals;
+    uint32_t    overruns;
+    timestamp_t cost; // moving average of the run time, in timestamp ticks
+} task_scheduler_stats_t;
+
+void                          task_scheduler_init(void);
+void                          task_scheduler_loop_begin(void);
+bool                          task_scheduler_task_begin(scheduled_task_t task);
+void                          task_scheduler_task_end(scheduled_task_t task);
+const char                   *task_scheduler_get_task_name(scheduled_task_t task);
+uint32_t                      task_scheduler_loop_overruns(void);
+const task_scheduler_stats_t *task_scheduler_get_stats(scheduled_task_t task);
+void                          task_scheduler_print(void);
+void                          task_scheduler_task(void);
+
+task_schedule_t task_scheduler_get_schedule_kb(scheduled_task_t task, task_schedule_t schedule);
+task_schedule_t task_scheduler_get_schedule_user(scheduled_task_t task, task_schedule_t schedule);
+
+#ifdef TASK_SCHEDULER_ENABLE
+#    define SCHEDULED_TASK(task, call)             \
+        do {                                       \
+            if (task_scheduler_task_begin(task)) { \
+                call;                              \
+                task_scheduler_task_end(task);     \
+            }                                      \
+        } while (0)
+#else
+#    define SCHEDULED_TASK(task, call) \
+        do {                           \
+            call;                      \
+        } while (0)
+#endif
@@ -17,6 +17,7 @@
 #include "unicode.h"
 
 #include "eeprom.h"
+#include "eeprom_write_behind.h"
 #include "eeconfig.h"
 #include "action.h"
 #include "action_util.h"
@@ -136,7 +137,7 @@ static void unicode_play_song(uint8_t mode) {
 #endif
 
 void unicode_input_mode_init(void) {
-    unicode_config.raw = eeprom_read_byte(EECONFIG_UNICODEMODE);
+    unicode_config.raw = eeprom_write_behind_read_byte(EECONFIG_UNICODEMODE);
 #if UNICODE_SELECTED_MODES != -1
 #    if UNICODE_CYCLE_PERSIST
     // Find input_mode in selected modes
@@ -165,7 +166,7 @@ uint8_t get_unicode_input_mode(void) {
 }
 
 static void persist_unicode_input_mode(void) {
-    eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
+    eeprom_write_behind_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
 }
 
 void set_unicode_input_mode(uint8_t mode) {
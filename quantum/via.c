@@ -22,6 +22,8 @@
 #    error "DYNAMIC_KEYMAP_ENABLE is not enabled"
 #endif
 
+#include <string.h>
+
 #include "via.h"
 
 #include "raw_hid.h"
@@ -30,6 +32,7 @@
 #include "eeconfig.h"
 #include "matrix.h"
 #include "timer.h"
+#include "util.h"
 #include "wait.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 
@@ -57,6 +60,18 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(PROFILER_ENABLE)
+#    include "profiler.h"
+#endif
+
+#if defined(LATENCY_TRACE_ENABLE)
+#    include "latency_trace.h"
+#endif
+
+#if defined(PROCESS_RECORD_PROFILER_ENABLE)
+#    include "process_record_profiler.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -276,6 +291,32 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+#ifdef VIA_BULK_TRANSFER
+// Where the next packet of a bulk write goes, and how many bytes are still to come
+static uint16_t via_bulk_set_offset    = 0;
+static uint16_t via_bulk_set_remaining = 0;
+#endif
+
+// Hands the profilers' commands to whichever of them they are addressed to
+static bool via_profilers_receive(uint8_t *data, uint8_t length) {
+#if defined(PROFILER_ENABLE)
+    if (profiler_raw_hid_receive(data, length)) {
+        return true;
+    }
+#endif
+#if defined(LATENCY_TRACE_ENABLE)
+    if (latency_trace_raw_hid_receive(data, length)) {
+        return true;
+    }
+#endif
+#if defined(PROCESS_RECORD_PROFILER_ENABLE)
+    if (process_record_profiler_raw_hid_receive(data, length)) {
+        return true;
+    }
+#endif
+    return false;
+}
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
@@ -286,6 +327,11 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         return;
     }
 
+    if (via_profilers_receive(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
@@ -436,6 +482,121 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+#ifdef VIA_BULK_TRANSFER
+        case id_dynamic_keymap_bulk_get_buffer: {
+            // data = [ command_id, offset(2), size(2) ]
+            // Answered with as many [ command_id, offset(2), keymap bytes ]
+            // packets as it takes, without waiting for the host in between
+            uint16_t offset      = (command_data[0] << 8) | command_data[1];
+            uint32_t size        = (command_data[2] << 8) | command_data[3];
+            uint32_t keymap_size = dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+            if (offset + size > keymap_size) {
+                size = offset < keymap_size ? keymap_size - offset : 0;
+            }
+            while (true) {
+                uint8_t chunk   = MIN(size, length - 3);
+                command_data[0] = offset >> 8;
+                command_data[1] = offset & 0xFF;
+                dynamic_keymap_get_buffer(offset, chunk, &command_data[2]);
+                memset(&command_data[2 + chunk], 0, length - 3 - chunk);
+                offset += chunk;
+                size -= chunk;
+                if (size == 0) {
+                    break;
+                }
+                raw_hid_send(data, length);
+            }
+            break;
+        }
+        case id_dynamic_keymap_bulk_set_buffer: {
+            // data = [ command_id, offset(2), size(2), keymap bytes ]
+            // The rest follows in id_dynamic_keymap_bulk_set_buffer_next
+            // packets, and only the last packet is answered
+            uint16_t offset = (command_data[0] << 8) | command_data[1];
+            uint16_t size   = (command_data[2] << 8) | command_data[3];
+            uint8_t  chunk  = MIN(size, length - 5);
+            dynamic_keymap_set_buffer(offset, chunk, &command_data[4]);
+            via_bulk_set_offset    = offset + chunk;
+            via_bulk_set_remaining = size - chunk;
+            if (via_bulk_set_remaining > 0) {
+                return;
+            }
+            break;
+        }
+        case id_dynamic_keymap_bulk_set_buffer_next: {
+            // data = [ command_id, offset(2), keymap bytes ]
+            uint16_t offset = (command_data[0] << 8) | command_data[1];
+            if (via_bulk_set_remaining == 0 || offset != via_bulk_set_offset) {
+                // A packet went missing, or there is no bulk write to continue
+                // The host has to start over
+                via_bulk_set_remaining = 0;
+                *command_id            = id_unhandled;
+                break;
+            }
+            uint8_t chunk = MIN(via_bulk_set_remaining, length - 3);
+            dynamic_keymap_set_buffer(offset, chunk, &command_data[2]);
+            via_bulk_set_offset += chunk;
+            via_bulk_set_remaining -= chunk;
+            if (via_bulk_set_remaining > 0) {
+                return;
+            }
+            break;
+        }
+#endif
+#ifdef DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE
+        case id_dynamic_keymap_get_changes: {
+            // data = [ command_id, epoch(2), generation(2) ]
+            // Answered with as many [ command_id, status, epoch(2),
+            // generation(2), count, (key index(2), keycode(2)) * count ]
+            // packets as it takes, the last one with id_keymap_changes_last.
+            // A generation from another epoch, i.e. from before a power-up,
+            // or one that has left the journal is answered with
+            // id_keymap_changes_stale, and the host has to read the whole
+            // keymap again.
+            uint16_t since_epoch = (command_data[0] << 8) | command_data[1];
+            uint16_t since       = (command_data[2] << 8) | command_data[3];
+            uint16_t epoch       = dynamic_keymap_get_epoch();
+            uint16_t generation  = dynamic_keymap_get_generation();
+            uint8_t  per_packet  = (length - 7) / 4;
+            uint8_t  count       = 0;
+            command_data[1]      = epoch >> 8;
+            command_data[2]      = epoch & 0xFF;
+            command_data[3]      = generation >> 8;
+            command_data[4]      = generation & 0xFF;
+            if (since_epoch != epoch || (uint16_t)(generation - since) > DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE) {
+                command_data[0] = id_keymap_changes_stale;
+                command_data[5] = 0;
+                break;
+            }
+            for (uint16_t changed = since; changed != generation; changed++) {
+                uint16_t index = dynamic_keymap_get_changed_key(changed);
+                // Only the latest change to each key is sent
+                bool superseded = false;
+                for (uint16_t later = changed + 1; later != generation && !superseded; later++) {
+                    superseded = dynamic_keymap_get_changed_key(later) == index;
+                }
+                if (superseded) {
+                    continue;
+                }
+                if (count == per_packet) {
+                    command_data[0] = id_keymap_changes_more;
+                    command_data[5] = count;
+                    raw_hid_send(data, length);
+                    count = 0;
+                }
+                uint16_t keycode = dynamic_keymap_get_keycode(index / (MATRIX_ROWS * MATRIX_COLS), (index / MATRIX_COLS) % MATRIX_ROWS, index % MATRIX_COLS);
+                uint8_t *entry   = &command_data[6 + count * 4];
+                entry[0]         = index >> 8;
+                entry[1]         = index & 0xFF;
+                entry[2]         = keycode >> 8;
+                entry[3]         = keycode & 0xFF;
+                count++;
+            }
+            command_data[0] = id_keymap_changes_last;
+            command_data[5] = count;
+            break;
+        }
+#endif
 #ifdef ENCODER_MAP_ENABLE
         case id_dynamic_keymap_get_encoder: {
             uint16_t keycode = dynamic_keymap_get_encoder(command_data[0], command_data[1], command_data[2] != 0);
@@ -93,6 +93,14 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    // QMK extensions, not part of VIA_PROTOCOL_VERSION. They exist only when
+    // VIA_BULK_TRANSFER or DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE is defined,
+    // and are otherwise answered with id_unhandled, which is how a host
+    // finds out whether it can use them.
+    id_dynamic_keymap_bulk_get_buffer       = 0x16,
+    id_dynamic_keymap_bulk_set_buffer       = 0x17,
+    id_dynamic_keymap_bulk_set_buffer_next  = 0x18,
+    id_dynamic_keymap_get_changes           = 0x19,
     id_unhandled                            = 0xFF,
 };
 
@@ -104,6 +112,12 @@ enum via_keyboard_value_id {
     id_device_indication   = 0x05,
 };
 
+enum via_keymap_changes_status {
+    id_keymap_changes_more  = 0x00,
+    id_keymap_changes_last  = 0x01,
+    id_keymap_changes_stale = 0xFF,
+};
+
 enum via_channel_id {
     id_custom_channel         = 0,
     id_qmk_backlight_channel  = 1,
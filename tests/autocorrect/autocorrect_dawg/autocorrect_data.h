@@ -0,0 +1,150 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by `qmk generate-autocorrect-data --dawg` from the default library.
+
+#pragma once
+
+// Autocorrection dictionary (70 entries):
+//   :guage     -> gauge
+//   :the:the:  -> the
+//   :thier     -> their
+//   :ture      -> true
+//   accomodate -> accommodate
+//   acommodate -> accommodate
+//   aparent    -> apparent
+//   aparrent   -> apparent
+//   apparant   -> apparent
+//   apparrent  -> apparent
+//   aquire     -> acquire
+//   becuase    -> because
+//   cauhgt     -> caught
+//   cheif      -> chief
+//   choosen    -> chosen
+//   cieling    -> ceiling
+//   collegue   -> colleague
+//   concensus  -> consensus
+//   contians   -> contains
+//   cosnt      -> const
+//   dervied    -> derived
+//   fales      -> false
+//   fasle      -> false
+//   fitler     -> filter
+//   flase      -> false
+//   foward     -> forward
+//   frequecy   -> frequency
+//   gaurantee  -> guarantee
+//   guaratee   -> guarantee
+//   heigth     -> height
+//   heirarchy  -> hierarchy
+//   inclued    -> include
+//   interator  -> iterator
+//   intput     -> input
+//   invliad    -> invalid
+//   lenght     -> length
+//   liasion    -> liaison
+//   libary     -> library
+//   listner    -> listener
+//   looses:    -> loses
+//   looup      -> lookup
+//   manefist   -> manifest
+//   namesapce  -> namespace
+//   namespcae  -> namespace
+//   occassion  -> occasion
+//   occured    -> occurred
+//   ouptut     -> output
+//   ouput      -> output
+//   overide    -> override
+//   postion    -> position
+//   priviledge -> privilege
+//   psuedo     -> pseudo
+//   recieve    -> receive
+//   refered    -> referred
+//   relevent   -> relevant
+//   repitition -> repetition
+//   retrun     -> return
+//   retun      -> return
+//   reuslt     -> result
+//   reutrn     -> return
+//   saftey     -> safety
+//   seperate   -> separate
+//   singed     -> signed
+//   stirng     -> string
+//   strign     -> string
+//   swithc     -> switch
+//   swtich     -> switch
+//   thresold   -> threshold
+//   udpate     -> update
+//   widht      -> width
+
+#define AUTOCORRECT_MIN_LENGTH 5 // ":ture"
+#define AUTOCORRECT_MAX_LENGTH 10 // "accomodate"
+#define DICTIONARY_SIZE 1025
+
+static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {
+    0x6C, 0x2B, 0x00, 0x06, 0x45, 0x00, 0x07, 0x4E, 0x00, 0x08, 0xBA, 0x00, 0x09, 0xCD, 0x01, 0x0A,
+    0xD6, 0x01, 0x0B, 0xF3, 0x01, 0x11, 0x0C, 0x02, 0x12, 0x8B, 0x02, 0x13, 0x96, 0x02, 0x15, 0x9F,
+    0x02, 0x16, 0xDB, 0x02, 0x17, 0x07, 0x03, 0x1C, 0xC5, 0x03, 0x00, 0x48, 0x32, 0x00, 0x16, 0x3B,
+    0x00, 0x00, 0x0B, 0x17, 0x2C, 0x08, 0x0B, 0x17, 0x2C, 0x84, 0x00, 0x08, 0x16, 0x12, 0x12, 0x0F,
+    0x84, 0x73, 0x65, 0x73, 0x00, 0x0B, 0x17, 0x0C, 0x1A, 0x16, 0x81, 0x63, 0x68, 0x00, 0x44, 0x5B,
+    0x00, 0x08, 0x66, 0x00, 0x0F, 0xA3, 0x00, 0x15, 0xAF, 0x00, 0x00, 0x0C, 0x0F, 0x19, 0x11, 0x0C,
+    0x83, 0x61, 0x6C, 0x69, 0x64, 0x00, 0x4A, 0x73, 0x00, 0x0C, 0x7C, 0x00, 0x15, 0x86, 0x00, 0x18,
+    0x9B, 0x00, 0x00, 0x11, 0x0C, 0x16, 0x83, 0x67, 0x6E, 0x65, 0x64, 0x00, 0x19, 0x15, 0x08, 0x07,
+    0x83, 0x69, 0x76, 0x65, 0x64, 0x00, 0x48, 0x8D, 0x00, 0x18, 0x95, 0x00, 0x00, 0x09, 0x08, 0x15,
+    0x81, 0x72, 0x65, 0x64, 0x00, 0x06, 0x06, 0x12, 0x01, 0x90, 0x00, 0x0F, 0x06, 0x11, 0x0C, 0x81,
+    0x64, 0x65, 0x00, 0x12, 0x16, 0x08, 0x15, 0x0B, 0x17, 0x82, 0x68, 0x6F, 0x6C, 0x64, 0x00, 0x04,
+    0x1A, 0x12, 0x09, 0x83, 0x72, 0x77, 0x61, 0x72, 0x64, 0x00, 0x44, 0xDC, 0x00, 0x06, 0xE8, 0x00,
+    0x07, 0xF5, 0x00, 0x08, 0x00, 0x01, 0x0A, 0x21, 0x01, 0x0F, 0x3C, 0x01, 0x15, 0x44, 0x01, 0x16,
+    0x5D, 0x01, 0x17, 0x75, 0x01, 0x18, 0xB6, 0x01, 0x19, 0xC2, 0x01, 0x00, 0x06, 0x13, 0x16, 0x08,
+    0x10, 0x04, 0x11, 0x82, 0x61, 0x63, 0x65, 0x00, 0x13, 0x04, 0x16, 0x08, 0x10, 0x04, 0x11, 0x83,
+    0x70, 0x61, 0x63, 0x65, 0x00, 0x0C, 0x15, 0x08, 0x19, 0x12, 0x82, 0x72, 0x69, 0x64, 0x65, 0x00,
+    0x17, 0x44, 0x08, 0x01, 0x11, 0x12, 0x01, 0x00, 0x15, 0x04, 0x18, 0x0A, 0x82, 0x6E, 0x74, 0x65,
+    0x65, 0x00, 0x04, 0x15, 0x18, 0x04, 0x0A, 0x87, 0x75, 0x61, 0x72, 0x61, 0x6E, 0x74, 0x65, 0x65,
+    0x00, 0x44, 0x28, 0x01, 0x07, 0x31, 0x01, 0x00, 0x18, 0x0A, 0x2C, 0x83, 0x61, 0x75, 0x67, 0x65,
+    0x00, 0x08, 0x0F, 0x0C, 0x19, 0x0C, 0x15, 0x13, 0x82, 0x67, 0x65, 0x00, 0x16, 0x04, 0x09, 0x82,
+    0x6C, 0x73, 0x65, 0x00, 0x4C, 0x4B, 0x01, 0x18, 0x56, 0x01, 0x00, 0x18, 0x14, 0x04, 0x84, 0x63,
+    0x71, 0x75, 0x69, 0x72, 0x65, 0x00, 0x17, 0x2C, 0x82, 0x72, 0x75, 0x65, 0x00, 0x04, 0x4F, 0x65,
+    0x01, 0x18, 0x6C, 0x01, 0x00, 0x09, 0x83, 0x61, 0x6C, 0x73, 0x65, 0x00, 0x06, 0x08, 0x05, 0x83,
+    0x61, 0x75, 0x73, 0x65, 0x00, 0x04, 0x47, 0x80, 0x01, 0x13, 0xA2, 0x01, 0x15, 0xAB, 0x01, 0x00,
+    0x12, 0x10, 0x50, 0x89, 0x01, 0x12, 0x97, 0x01, 0x00, 0x12, 0x06, 0x04, 0x87, 0x63, 0x6F, 0x6D,
+    0x6D, 0x6F, 0x64, 0x61, 0x74, 0x65, 0x00, 0x06, 0x06, 0x04, 0x84, 0x6D, 0x6F, 0x64, 0x61, 0x74,
+    0x65, 0x00, 0x07, 0x18, 0x84, 0x70, 0x64, 0x61, 0x74, 0x65, 0x00, 0x08, 0x13, 0x08, 0x16, 0x84,
+    0x61, 0x72, 0x61, 0x74, 0x65, 0x00, 0x0A, 0x08, 0x0F, 0x0F, 0x12, 0x06, 0x82, 0x61, 0x67, 0x75,
+    0x65, 0x00, 0x08, 0x0C, 0x06, 0x08, 0x15, 0x83, 0x65, 0x69, 0x76, 0x65, 0x00, 0x0C, 0x08, 0x0B,
+    0x06, 0x82, 0x69, 0x65, 0x66, 0x00, 0x11, 0x4C, 0xDE, 0x01, 0x15, 0xEA, 0x01, 0x00, 0x0F, 0x08,
+    0x0C, 0x06, 0x85, 0x65, 0x69, 0x6C, 0x69, 0x6E, 0x67, 0x00, 0x0C, 0x17, 0x16, 0x83, 0x72, 0x69,
+    0x6E, 0x67, 0x00, 0x46, 0xFA, 0x01, 0x17, 0x04, 0x02, 0x00, 0x0C, 0x17, 0x1A, 0x16, 0x83, 0x69,
+    0x74, 0x63, 0x68, 0x00, 0x0A, 0x0C, 0x08, 0x0B, 0x81, 0x68, 0x74, 0x00, 0x48, 0x1C, 0x02, 0x0A,
+    0x26, 0x02, 0x12, 0x2E, 0x02, 0x15, 0x6C, 0x02, 0x18, 0x76, 0x02, 0x00, 0x16, 0x12, 0x12, 0x0B,
+    0x06, 0x83, 0x73, 0x65, 0x6E, 0x00, 0x0C, 0x15, 0x17, 0x16, 0x81, 0x6E, 0x67, 0x00, 0x0C, 0x56,
+    0x36, 0x02, 0x17, 0x4E, 0x02, 0x00, 0x44, 0x3D, 0x02, 0x16, 0x45, 0x02, 0x00, 0x0C, 0x0F, 0x83,
+    0x69, 0x73, 0x6F, 0x6E, 0x00, 0x04, 0x06, 0x06, 0x12, 0x83, 0x69, 0x6F, 0x6E, 0x00, 0x4C, 0x55,
+    0x02, 0x16, 0x63, 0x02, 0x00, 0x17, 0x0C, 0x13, 0x08, 0x15, 0x86, 0x65, 0x74, 0x69, 0x74, 0x69,
+    0x6F, 0x6E, 0x00, 0x12, 0x13, 0x83, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x00, 0x17, 0x18, 0x08, 0x15,
+    0x83, 0x74, 0x75, 0x72, 0x6E, 0x00, 0x55, 0x7D, 0x02, 0x17, 0x85, 0x02, 0x00, 0x17, 0x08, 0x15,
+    0x82, 0x75, 0x72, 0x6E, 0x00, 0x08, 0x15, 0x80, 0x72, 0x6E, 0x00, 0x07, 0x08, 0x18, 0x16, 0x13,
+    0x83, 0x65, 0x75, 0x64, 0x6F, 0x00, 0x18, 0x12, 0x12, 0x0F, 0x81, 0x6B, 0x75, 0x70, 0x00, 0x48,
+    0xA6, 0x02, 0x12, 0xCB, 0x02, 0x00, 0x4C, 0xB0, 0x02, 0x0F, 0xB8, 0x02, 0x11, 0xC1, 0x02, 0x00,
+    0x0B, 0x17, 0x2C, 0x82, 0x65, 0x69, 0x72, 0x00, 0x17, 0x0C, 0x09, 0x83, 0x6C, 0x74, 0x65, 0x72,
+    0x00, 0x17, 0x16, 0x0C, 0x0F, 0x82, 0x65, 0x6E, 0x65, 0x72, 0x00, 0x17, 0x04, 0x15, 0x08, 0x17,
+    0x11, 0x0C, 0x87, 0x74, 0x65, 0x72, 0x61, 0x74, 0x6F, 0x72, 0x00, 0x48, 0xE5, 0x02, 0x11, 0xEC,
+    0x02, 0x18, 0xF8, 0x02, 0x00, 0x0F, 0x04, 0x09, 0x81, 0x73, 0x65, 0x00, 0x04, 0x0C, 0x17, 0x11,
+    0x12, 0x06, 0x83, 0x61, 0x69, 0x6E, 0x73, 0x00, 0x16, 0x11, 0x08, 0x06, 0x11, 0x12, 0x06, 0x85,
+    0x73, 0x65, 0x6E, 0x73, 0x75, 0x73, 0x00, 0x4A, 0x1A, 0x03, 0x0B, 0x23, 0x03, 0x0F, 0x36, 0x03,
+    0x11, 0x40, 0x03, 0x16, 0x93, 0x03, 0x18, 0xA0, 0x03, 0x00, 0x0B, 0x18, 0x04, 0x06, 0x82, 0x67,
+    0x68, 0x74, 0x00, 0x47, 0x2A, 0x03, 0x0A, 0x30, 0x03, 0x00, 0x0C, 0x1A, 0x81, 0x74, 0x68, 0x00,
+    0x11, 0x08, 0x0F, 0x01, 0x2C, 0x03, 0x16, 0x18, 0x08, 0x15, 0x83, 0x73, 0x75, 0x6C, 0x74, 0x00,
+    0x44, 0x4A, 0x03, 0x08, 0x54, 0x03, 0x16, 0x8C, 0x03, 0x00, 0x15, 0x04, 0x13, 0x13, 0x04, 0x82,
+    0x65, 0x6E, 0x74, 0x00, 0x55, 0x5B, 0x03, 0x19, 0x83, 0x03, 0x00, 0x44, 0x62, 0x03, 0x15, 0x6C,
+    0x03, 0x00, 0x13, 0x04, 0x84, 0x70, 0x61, 0x72, 0x65, 0x6E, 0x74, 0x00, 0x04, 0x13, 0x44, 0x75,
+    0x03, 0x13, 0x7D, 0x03, 0x00, 0x85, 0x70, 0x61, 0x72, 0x65, 0x6E, 0x74, 0x00, 0x04, 0x83, 0x65,
+    0x6E, 0x74, 0x00, 0x08, 0x0F, 0x08, 0x15, 0x82, 0x61, 0x6E, 0x74, 0x00, 0x12, 0x06, 0x82, 0x6E,
+    0x73, 0x74, 0x00, 0x0C, 0x09, 0x08, 0x11, 0x04, 0x10, 0x84, 0x69, 0x66, 0x65, 0x73, 0x74, 0x00,
+    0x53, 0xA7, 0x03, 0x17, 0xBC, 0x03, 0x00, 0x57, 0xAE, 0x03, 0x18, 0xB5, 0x03, 0x00, 0x11, 0x0C,
+    0x83, 0x70, 0x75, 0x74, 0x00, 0x12, 0x82, 0x74, 0x70, 0x75, 0x74, 0x00, 0x13, 0x18, 0x12, 0x83,
+    0x74, 0x70, 0x75, 0x74, 0x00, 0x46, 0xD2, 0x03, 0x08, 0xDD, 0x03, 0x0B, 0xE6, 0x03, 0x15, 0xF7,
+    0x03, 0x00, 0x08, 0x18, 0x14, 0x08, 0x15, 0x09, 0x81, 0x6E, 0x63, 0x79, 0x00, 0x17, 0x09, 0x04,
+    0x16, 0x82, 0x65, 0x74, 0x79, 0x00, 0x06, 0x15, 0x04, 0x15, 0x0C, 0x08, 0x0B, 0x87, 0x69, 0x65,
+    0x72, 0x61, 0x72, 0x63, 0x68, 0x79, 0x00, 0x04, 0x05, 0x0C, 0x0F, 0x82, 0x72, 0x61, 0x72, 0x79,
+    0x00
+};
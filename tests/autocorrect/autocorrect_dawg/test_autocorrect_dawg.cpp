@@ -0,0 +1,108 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+// autocorrect_data.h holds the default library, serialized as a DAWG
+class AutoCorrectDawg : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+
+        for (uint8_t i = 0; i < 26; i++) {
+            add_key(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i));
+        }
+        add_key(KeymapKey(0, 6, 2, KC_SPC));
+    }
+
+    void TypeString(const char *str) {
+        for (; *str; str++) {
+            const uint8_t index = *str == ' ' ? 26 : *str - 'a';
+            const uint8_t col   = index == 26 ? 6 : index % MATRIX_COLS;
+            const uint8_t row   = index == 26 ? 2 : index / MATRIX_COLS;
+            press_key(col, row);
+            run_one_scan_loop();
+            release_key(col, row);
+            run_one_scan_loop();
+        }
+    }
+};
+
+// "fales" is reached through branches and a chain running into its leaf
+TEST_F(AutoCorrectDawg, ChainIntoLeaf) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+    TypeString("fales");
+    VERIFY_AND_CLEAR(driver);
+}
+
+// "lenght" ends in a chain linking to a node shared with another typo
+TEST_F(AutoCorrectDawg, ChainLinkToSharedNode) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_N)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_G)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_H)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_T)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_H)));
+    }
+    TypeString("lenght");
+    VERIFY_AND_CLEAR(driver);
+}
+
+// "occured" takes the same kind of link, deeper in the DAWG
+TEST_F(AutoCorrectDawg, LinkDeepInDawg) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_O)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_U)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_R)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_R)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_D)));
+    }
+    TypeString("occured");
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Words sharing most of their path with typos are left alone
+TEST_F(AutoCorrectDawg, CorrectWordsUntouched) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE))).Times(0);
+    TypeString("length occurred overture ");
+    VERIFY_AND_CLEAR(driver);
+}
@@ -20,7 +20,26 @@
 using testing::_;
 using testing::InSequence;
 
-class KeyPress : public TestFixture {};
+extern "C" void advance_time(uint32_t ms);
+
+// How long processing a KC_F24 press takes, to have time pass in the middle
+// of the events of one scan
+static uint32_t slow_key_processing_time = 0;
+
+extern "C" bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == KC_F24 && record->event.pressed) {
+        advance_time(slow_key_processing_time);
+    }
+    return true;
+}
+
+class KeyPress : public TestFixture {
+   public:
+    void TearDown() override {
+        slow_key_processing_time = 0;
+        TestFixture::TearDown();
+    }
+};
 
 TEST_F(KeyPress, SendKeyboardIsNotCalledWhenNoKeyIsPressed) {
     TestDriver driver;
@@ -76,6 +95,76 @@ TEST_F(KeyPress, CorrectKeysAreReportedWhenTwoKeysArePressed) {
     keyboard_task();
 }
 
+TEST_F(KeyPress, MoreKeysThanTheEventQueueHoldsAreReportedInMatrixOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_lctl = KeymapKey(0, 0, 0, KC_LEFT_CTRL);
+    auto       key_lsft = KeymapKey(0, 1, 0, KC_LEFT_SHIFT);
+    auto       key_lalt = KeymapKey(0, 2, 0, KC_LEFT_ALT);
+    auto       key_lgui = KeymapKey(0, 3, 0, KC_LEFT_GUI);
+    auto       key_rctl = KeymapKey(0, 4, 0, KC_RIGHT_CTRL);
+    auto       key_rsft = KeymapKey(0, 5, 0, KC_RIGHT_SHIFT);
+    auto       key_ralt = KeymapKey(0, 6, 0, KC_RIGHT_ALT);
+    auto       key_rgui = KeymapKey(0, 7, 0, KC_RIGHT_GUI);
+    auto       key_a    = KeymapKey(0, 8, 0, KC_A);
+
+    set_keymap({key_lctl, key_lsft, key_lalt, key_lgui, key_rctl, key_rsft, key_ralt, key_rgui, key_a});
+
+    for (auto key : {key_lctl, key_lsft, key_lalt, key_lgui, key_rctl, key_rsft, key_ralt, key_rgui, key_a}) {
+        key.press();
+    }
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_LEFT_ALT));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI, KC_RIGHT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI, KC_RIGHT_CTRL, KC_RIGHT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI, KC_RIGHT_CTRL, KC_RIGHT_SHIFT, KC_RIGHT_ALT));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI, KC_RIGHT_CTRL, KC_RIGHT_SHIFT, KC_RIGHT_ALT, KC_RIGHT_GUI));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI, KC_RIGHT_CTRL, KC_RIGHT_SHIFT, KC_RIGHT_ALT, KC_RIGHT_GUI, KC_A));
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+
+    for (auto key : {key_lctl, key_lsft, key_lalt, key_lgui, key_rctl, key_rsft, key_ralt, key_rgui, key_a}) {
+        key.release();
+    }
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(8);
+    EXPECT_EMPTY_REPORT(driver);
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyPress, EventsOfOneScanAreTimedAtTheScan) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_slow    = KeymapKey(0, 0, 0, KC_F24);
+    auto       mod_tap_key = KeymapKey(0, 0, 1, SFT_T(KC_A));
+
+    set_keymap({key_slow, mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM - 20);
+    VERIFY_AND_CLEAR(driver);
+
+    // The release is scanned within the tapping term, but only processed
+    // after the slow key has taken it past the end of the term
+    slow_key_processing_time = 50;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_F24));
+    EXPECT_REPORT(driver, (KC_F24));
+    key_slow.press();
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_slow.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
 TEST_F(KeyPress, LeftShiftIsReportedCorrectly) {
     TestDriver driver;
     auto       key_a    = KeymapKey(0, 0, 0, KC_A);
@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+CHORDS_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_chords.c
@@ -0,0 +1,134 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class Chords : public TestFixture {};
+
+TEST_F(Chords, ChordFiresOnceAllKeysAreReleased) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    EXPECT_NO_REPORT(driver);
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chords, RolledKeysFormTheirUnion) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_F3));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    key_c.press();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chords, ChordsSpanMaskWords) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_7 = KeymapKey(0, 3, 0, KC_7);
+    auto       key_8 = KeymapKey(0, 4, 0, KC_8);
+
+    set_keymap({key_a, key_7, key_8});
+
+    EXPECT_REPORT(driver, (KC_F4));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_8});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_F5));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_7, key_8});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chords, UnmatchedKeysAreTappedInOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_d = KeymapKey(0, 1, 0, KC_D);
+
+    set_keymap({key_a, key_d});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_d, key_a});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chords, OtherKeysAreUnaffected) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_9 = KeymapKey(0, 1, 0, KC_9);
+
+    set_keymap({key_a, key_9});
+
+    EXPECT_REPORT(driver, (KC_9));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_9);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Chords, LookupFindsEveryChord) {
+    for (uint16_t i = 0; i < chord_count(); i++) {
+        const chord_t *chord = chord_get(i);
+        EXPECT_EQ(chord_lookup(chord->mask), chord->keycode);
+    }
+
+    const uint32_t missing[CHORD_MASK_WORDS] = {0x00000006, 0x0};
+    EXPECT_EQ(chord_lookup(missing), KC_NO);
+}
@@ -0,0 +1,20 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+// clang-format off
+const uint16_t PROGMEM chord_keys[] = {
+    KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M,
+    KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z,
+    KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8,
+};
+
+// Sorted by mask; bits 32 and 33 are KC_7 and KC_8
+const chord_t PROGMEM key_chords[] = {
+    {{0x00000003, 0x0}, KC_F1},       // A B
+    {{0x00000005, 0x0}, KC_F2},       // A C
+    {{0x00000007, 0x0}, KC_F3},       // A B C
+    {{0x00000001, 0x2}, KC_F4},       // A 8
+    {{0x00000000, 0x3}, LSFT(KC_F5)}, // 7 8
+};
+// clang-format on
@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+enum combos { ab_combo, bc_combo, abc_combo, repeated_combo };
+
+uint16_t const ab_keys[]       = {KC_A, KC_B, COMBO_END};
+uint16_t const bc_keys[]       = {KC_B, KC_C, COMBO_END};
+uint16_t const abc_keys[]      = {KC_A, KC_B, KC_C, COMBO_END};
+uint16_t const repeated_keys[] = {KC_D, KC_E, KC_D, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab_combo]       = COMBO(ab_keys, KC_X),
+    [bc_combo]       = COMBO(bc_keys, KC_Y),
+    [abc_combo]      = COMBO(abc_keys, KC_Z),
+    [repeated_combo] = COMBO(repeated_keys, KC_W),
+};
+// clang-format on
@@ -0,0 +1,121 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "eeprom_driver.h"
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+
+class DynamicKeymapMirror : public TestFixture {
+   protected:
+    void SetUp() override {
+        // Start every test from an all-KC_NO keymap, both in EEPROM and RAM
+        for (uint16_t i = 0; i < dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2; i++) {
+            eeprom_update_byte((uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 0, 0) + i, 0);
+        }
+        dynamic_keymap_mirror_load();
+    }
+
+    uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(DynamicKeymapMirror, WritesAreServedFromRamUntilWrittenBack) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    dynamic_keymap_set_keycode(1, 2, 3, LT(1, KC_A));
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), LT(1, KC_A));
+    EXPECT_EQ(eeprom_keycode(1, 2, 3), KC_NO);
+
+    idle_for(DYNAMIC_KEYMAP_WRITE_BACK_DELAY - 10);
+    EXPECT_EQ(eeprom_keycode(1, 2, 3), KC_NO);
+
+    idle_for(20);
+    EXPECT_EQ(eeprom_keycode(1, 2, 3), LT(1, KC_A));
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), LT(1, KC_A));
+}
+
+TEST_F(DynamicKeymapMirror, BurstsAreWrittenBackOnceSettled) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    for (uint8_t i = 0; i < 10; i++) {
+        dynamic_keymap_set_keycode(0, 0, i, KC_A + i);
+        idle_for(DYNAMIC_KEYMAP_WRITE_BACK_DELAY / 2);
+    }
+    EXPECT_EQ(eeprom_keycode(0, 0, 0), KC_NO);
+
+    idle_for(DYNAMIC_KEYMAP_WRITE_BACK_DELAY);
+    for (uint8_t i = 0; i < 10; i++) {
+        EXPECT_EQ(eeprom_keycode(0, 0, i), KC_A + i);
+    }
+}
+
+TEST_F(DynamicKeymapMirror, BufferAccessGoesThroughTheMirror) {
+    const uint8_t keys[] = {0x12, 0x34, 0x00, KC_B};
+    const uint16_t offset = (MATRIX_ROWS * MATRIX_COLS + 1) * 2 + 1;
+
+    // Starts halfway through a keycode
+    dynamic_keymap_set_buffer(offset, sizeof(keys), (uint8_t *)keys);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 1), 0x0012);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 2), 0x3400);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 3), KC_B << 8);
+
+    uint8_t read[sizeof(keys)];
+    dynamic_keymap_get_buffer(offset, sizeof(read), read);
+    EXPECT_EQ(memcmp(read, keys, sizeof(keys)), 0);
+
+    dynamic_keymap_flush();
+    EXPECT_EQ(eeprom_keycode(1, 0, 1), 0x0012);
+    EXPECT_EQ(eeprom_keycode(1, 0, 2), 0x3400);
+}
+
+TEST_F(DynamicKeymapMirror, WrittenBackOnSuspend) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    dynamic_keymap_set_keycode(1, 3, 9, KC_Z);
+    EXPECT_EQ(eeprom_keycode(1, 3, 9), KC_NO);
+
+    suspend_power_down_quantum();
+    EXPECT_EQ(eeprom_keycode(1, 3, 9), KC_Z);
+}
+
+TEST_F(DynamicKeymapMirror, ResetIsWrittenStraightAway) {
+    dynamic_keymap_reset();
+    for (uint8_t layer = 0; layer < dynamic_keymap_get_layer_count(); layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(eeprom_keycode(layer, row, column), dynamic_keymap_get_keycode(layer, row, column));
+            }
+        }
+    }
+}
+
+TEST_F(DynamicKeymapMirror, ResetAfterEraseRewritesEveryKey) {
+    // The mirror holds the default keymap when the EEPROM is erased
+    dynamic_keymap_reset();
+    eeprom_driver_erase();
+
+    dynamic_keymap_reset();
+    dynamic_keymap_flush();
+    dynamic_keymap_mirror_load();
+    for (uint8_t layer = 0; layer < dynamic_keymap_get_layer_count(); layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, column), keycode_at_keymap_location_raw(layer, row, column));
+            }
+        }
+    }
+}
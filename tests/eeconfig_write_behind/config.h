@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_WRITE_BEHIND_IDLE_TIMEOUT 100
+
+#define RGBLIGHT_LED_COUNT 1
+#define TRANSIENT_EEPROM_SIZE 64
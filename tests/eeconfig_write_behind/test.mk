@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+EEPROM_WRITE_BEHIND_ENABLE = yes
+# The test harness EEPROM is too small to hold the whole eeconfig area
+EEPROM_DRIVER = transient
+
+RGBLIGHT_ENABLE = yes
+RGBLIGHT_DRIVER = custom
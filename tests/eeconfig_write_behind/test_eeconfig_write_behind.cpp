@@ -0,0 +1,63 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef __cplusplus
+// rgblight.h is pulled in ahead of keycode_config.h, which normally does this
+#    define _Static_assert static_assert
+#endif
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgblight_drivers.h"
+
+static void setleds(rgb_led_t *ledarray, uint16_t number_of_leds) {}
+
+const rgblight_driver_t rgblight_driver = {
+    .setleds = setleds,
+};
+}
+
+class EeconfigWriteBehind : public TestFixture {};
+
+TEST_F(EeconfigWriteBehind, RgblightUpdateAfterInitSurvivesSync) {
+    TestDriver driver;
+
+    // Queues zeroed lighting settings, then rgblight writes its own straight after
+    eeconfig_init();
+    rgblight_enable();
+    rgblight_sethsv(100, 150, 200);
+    uint32_t expected = eeconfig_read_rgblight();
+    EXPECT_TRUE(rgblight_is_enabled());
+    EXPECT_EQ(rgblight_get_hue(), 100);
+
+    idle_for(EEPROM_WRITE_BEHIND_IDLE_TIMEOUT * 2);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_RGBLIGHT), expected);
+    EXPECT_EQ(eeconfig_read_rgblight(), expected);
+
+    // What rgblight picks up at the next power-up
+    rgblight_disable_noeeprom();
+    rgblight_sethsv_noeeprom(0, 0, 0);
+    rgblight_reload_from_eeprom();
+    EXPECT_TRUE(rgblight_is_enabled());
+    EXPECT_EQ(rgblight_get_hue(), 100);
+    EXPECT_EQ(rgblight_get_sat(), 150);
+    EXPECT_EQ(rgblight_get_val(), 200);
+}
+
+TEST_F(EeconfigWriteBehind, LightingBurstIsWrittenOnceIdle) {
+    TestDriver driver;
+
+    eeconfig_init();
+    rgblight_enable();
+    eeprom_write_behind_sync();
+    for (uint8_t i = 0; i < 10; i++) {
+        rgblight_increase_hue();
+        idle_for(EEPROM_WRITE_BEHIND_IDLE_TIMEOUT / 4);
+    }
+    uint32_t expected = eeconfig_read_rgblight();
+    EXPECT_NE(eeprom_read_dword(EECONFIG_RGBLIGHT), expected);
+
+    idle_for(EEPROM_WRITE_BEHIND_IDLE_TIMEOUT * 2);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_RGBLIGHT), expected);
+}
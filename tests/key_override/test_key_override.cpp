@@ -0,0 +1,183 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+extern const key_override_t *test_key_overrides[];
+extern const key_override_t *test_other_key_overrides[];
+}
+
+class KeyOverride : public TestFixture {
+   protected:
+    void TearDown() override {
+        key_overrides = test_key_overrides;
+    }
+};
+
+TEST_F(KeyOverride, TriggerReplacedWhileModsHeld) {
+    TestDriver driver;
+    InSequence s;
+    auto       shift     = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       backspace = KeymapKey(0, 1, 0, KC_BSPC);
+
+    set_keymap({shift, backspace});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_DEL));
+    backspace.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    backspace.release();
+    run_one_scan_loop();
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, UnrelatedKeysAreUntouched) {
+    TestDriver driver;
+    InSequence s;
+    auto       shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({shift, key_a});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    shift.press();
+    run_one_scan_loop();
+    tap_key(key_a);
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, FirstMatchingOverrideWins) {
+    TestDriver driver;
+    InSequence s;
+    auto       ctrl  = KeymapKey(0, 0, 0, KC_LCTL);
+    auto       shift = KeymapKey(0, 1, 0, KC_LSFT);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({ctrl, shift, key_c});
+
+    // Both Ctrl + C overrides match, the one listed first is used
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    ctrl.press();
+    run_one_scan_loop();
+    tap_key(key_c);
+    ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Only the second one accepts Shift on its own
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    shift.press();
+    run_one_scan_loop();
+    tap_key(key_c);
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, NegativeModsPreventActivation) {
+    TestDriver driver;
+    InSequence s;
+    auto       alt   = KeymapKey(0, 0, 0, KC_LALT);
+    auto       shift = KeymapKey(0, 1, 0, KC_LSFT);
+    auto       key_e = KeymapKey(0, 2, 0, KC_E);
+
+    set_keymap({alt, shift, key_e});
+
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_LSFT, KC_E));
+    EXPECT_REPORT(driver, (KC_LALT, KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    alt.press();
+    run_one_scan_loop();
+    shift.press();
+    run_one_scan_loop();
+    tap_key(key_e);
+    alt.release();
+    run_one_scan_loop();
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, ActivatedByModifierWhileTriggerHeld) {
+    TestDriver driver;
+    InSequence s;
+    auto       shift     = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       backspace = KeymapKey(0, 1, 0, KC_BSPC);
+
+    set_keymap({shift, backspace});
+
+    EXPECT_REPORT(driver, (KC_BSPC));
+    backspace.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The trigger and the suppressed Shift are lifted at once, the replacement
+    // is only registered once the repeat delay has passed
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_DEL));
+    shift.press();
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    backspace.release();
+    run_one_scan_loop();
+    shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, ReplacedListIsPickedUp) {
+    TestDriver driver;
+    InSequence s;
+    auto       ctrl  = KeymapKey(0, 0, 0, KC_LCTL);
+    auto       key_c = KeymapKey(0, 1, 0, KC_C);
+
+    set_keymap({ctrl, key_c});
+
+    key_overrides = test_other_key_overrides;
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    ctrl.press();
+    run_one_scan_loop();
+    tap_key(key_c);
+    ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,25 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+const key_override_t delete_override  = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t ctrl_c_override  = ko_make_basic(MOD_MASK_CTRL, KC_C, KC_X);
+const key_override_t any_c_override   = ko_make_with_layers_negmods_and_options(MOD_MASK_CS, KC_C, KC_Y, ~0, 0, ko_options_default | ko_option_one_mod);
+const key_override_t no_shift_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_E, KC_Z, ~0, MOD_MASK_SHIFT);
+
+// clang-format off
+const key_override_t *test_key_overrides[] = {
+    &delete_override,
+    &ctrl_c_override,
+    &any_c_override,
+    &no_shift_override,
+    NULL,
+};
+
+const key_override_t *test_other_key_overrides[] = {
+    &any_c_override,
+    NULL,
+};
+// clang-format on
+
+const key_override_t **key_overrides = test_key_overrides;
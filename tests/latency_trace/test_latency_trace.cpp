@@ -0,0 +1,217 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LatencyTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_trace_reset();
+    }
+};
+
+TEST_F(LatencyTrace, plain_key_has_no_added_latency) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    for (uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        EXPECT_EQ(latency_trace_get_stats((latency_stage_t)stage)->count, 2);
+        EXPECT_EQ(latency_trace_get_stats((latency_stage_t)stage)->max, 0);
+    }
+    EXPECT_EQ(latency_trace_dropped(), 0);
+}
+
+TEST_F(LatencyTrace, mod_tap_hold_adds_tapping_term) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  mod_tap_key(0, 0, 0, SFT_T(KC_A));
+    set_keymap({mod_tap_key});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The press waits out the tapping term before it is processed
+    const latency_stats_t *process_record = latency_trace_get_stats(LATENCY_STAGE_PROCESS_RECORD);
+    EXPECT_EQ(process_record->count, 2);
+    EXPECT_GE(process_record->max, TAPPING_TERM * 1000);
+    EXPECT_LE(process_record->max, (TAPPING_TERM + 1) * 1000);
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->max, process_record->max);
+
+    // ... while action_exec sees it immediately
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_ACTION_EXEC)->max, 0);
+
+    // Only the press was delayed, so the median is the undelayed release
+    EXPECT_EQ(latency_trace_percentile(LATENCY_STAGE_HOST_SEND, 50), 0);
+    EXPECT_EQ(latency_trace_percentile(LATENCY_STAGE_HOST_SEND, 99), process_record->max);
+}
+
+TEST_F(LatencyTrace, mod_tap_tap_is_delayed_until_release) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  mod_tap_key(0, 0, 0, SFT_T(KC_A));
+    set_keymap({mod_tap_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(mod_tap_key, 50);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->count, 2);
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->max, 50 * 1000);
+}
+
+TEST_F(LatencyTrace, nkro_reports_complete_traces) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    keymap_config.nkro = true;
+    EXPECT_NO_REPORT(driver);
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(2);
+    tap_key(key_a, 20);
+    VERIFY_AND_CLEAR(driver);
+    keymap_config.nkro = false;
+
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->count, 2);
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->max, 0);
+    EXPECT_EQ(latency_trace_dropped(), 0);
+}
+
+TEST_F(LatencyTrace, combo_is_delayed_until_combo_term) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_y(0, 0, 0, KC_Y);
+    KeymapKey  key_u(0, 1, 0, KC_U);
+    set_keymap({key_y, key_u});
+
+    EXPECT_REPORT(driver, (KC_C));
+    key_y.press();
+    idle_for(10);
+    key_u.press();
+    idle_for(COMBO_TERM + 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_y.release();
+    key_u.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Both presses are held back until the combo term runs out after the
+    // second one, and then completed by the combo
+    const latency_stats_t *process_record = latency_trace_get_stats(LATENCY_STAGE_PROCESS_RECORD);
+    EXPECT_EQ(process_record->count, 4);
+    EXPECT_GE(process_record->max, (10 + COMBO_TERM) * 1000);
+    EXPECT_LE(process_record->max, (10 + COMBO_TERM + 2) * 1000);
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->max, process_record->max);
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_ACTION_EXEC)->max, 0);
+    EXPECT_EQ(latency_trace_dropped(), 0);
+}
+
+TEST_F(LatencyTrace, combo_does_not_complete_pending_mod_tap) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_y(0, 0, 0, KC_Y);
+    KeymapKey  key_u(0, 1, 0, KC_U);
+    KeymapKey  mod_tap_key(0, 2, 0, SFT_T(KC_A));
+    set_keymap({key_y, key_u, mod_tap_key});
+
+    // The mod-tap press fires the combo and is then held in the tapping
+    // buffer, where the combo must not mark it as processed
+    EXPECT_REPORT(driver, (KC_C));
+    key_y.press();
+    run_one_scan_loop();
+    key_u.press();
+    run_one_scan_loop();
+    mod_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_C, KC_LEFT_SHIFT));
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_y.release();
+    key_u.release();
+    run_one_scan_loop();
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    const latency_stats_t *process_record = latency_trace_get_stats(LATENCY_STAGE_PROCESS_RECORD);
+    EXPECT_EQ(process_record->count, 6);
+    EXPECT_GE(process_record->max, TAPPING_TERM * 1000);
+    EXPECT_LE(process_record->max, (TAPPING_TERM + 1) * 1000);
+    EXPECT_EQ(latency_trace_dropped(), 0);
+}
+
+TEST_F(LatencyTrace, key_override_has_no_added_latency) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_DELETE));
+    key_bspc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_bspc.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->count, 4);
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->max, 0);
+    EXPECT_EQ(latency_trace_dropped(), 0);
+}
+
+TEST_F(LatencyTrace, raw_hid_reports_stats) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    uint8_t data[32] = {LATENCY_TRACE_RAW_HID_COMMAND_ID, latency_trace_raw_hid_get_stats, LATENCY_STAGE_HOST_SEND};
+    EXPECT_TRUE(latency_trace_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], latency_trace_raw_hid_get_stats);
+    EXPECT_EQ(data[3], 2);
+
+    uint8_t reset[32] = {LATENCY_TRACE_RAW_HID_COMMAND_ID, latency_trace_raw_hid_reset};
+    EXPECT_TRUE(latency_trace_raw_hid_receive(reset, sizeof(reset)));
+    EXPECT_EQ(latency_trace_get_stats(LATENCY_STAGE_HOST_SEND)->count, 0);
+}
@@ -0,0 +1,22 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+uint16_t const yu_combo[] = {KC_Y, KC_U, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    COMBO(yu_combo, KC_C),
+};
+// clang-format on
+
+const key_override_t delete_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+
+// clang-format off
+const key_override_t *test_key_overrides[] = {
+    &delete_override,
+    NULL,
+};
+// clang-format on
+
+const key_override_t **key_overrides = test_key_overrides;
@@ -0,0 +1,115 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerLookupCache : public TestFixture {
+   protected:
+    void SetUp() override {
+        // Every test installs its own keymap
+        layer_lookup_cache_invalidate();
+    }
+};
+
+TEST_F(LayerLookupCache, MomentaryLayerIsResolvedWhileHeld) {
+    TestDriver driver;
+    InSequence s;
+    auto       layer_key = KeymapKey(0, 0, 0, MO(1));
+    auto       base_key  = KeymapKey(0, 1, 0, KC_A);
+    auto       upper_key = KeymapKey(1, 1, 0, KC_B);
+
+    set_keymap({layer_key, base_key, upper_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(base_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(upper_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(base_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, TransparentKeyFallsThroughToLowerLayer) {
+    TestDriver driver;
+    InSequence s;
+    auto       base_key  = KeymapKey(0, 1, 0, KC_A);
+    auto       upper_key = KeymapKey(1, 1, 0, KC_TRNS);
+
+    set_keymap({base_key, upper_key});
+    layer_on(1);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(upper_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, DefaultLayerChangeIsSeen) {
+    TestDriver driver;
+    InSequence s;
+    auto       base_key  = KeymapKey(0, 1, 0, KC_A);
+    auto       other_key = KeymapKey(2, 1, 0, KC_C);
+
+    set_keymap({base_key, other_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(base_key);
+    VERIFY_AND_CLEAR(driver);
+
+    default_layer_set((layer_state_t)1 << 2);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(other_key);
+    VERIFY_AND_CLEAR(driver);
+
+    default_layer_set(1);
+}
+
+TEST_F(LayerLookupCache, KeymapChangeIsSeenOnceInvalidated) {
+    TestDriver driver;
+    InSequence s;
+    auto       old_key = KeymapKey(0, 1, 0, KC_A);
+    auto       new_key = KeymapKey(0, 1, 0, KC_D);
+
+    set_keymap({old_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(old_key);
+    VERIFY_AND_CLEAR(driver);
+
+    /* As dynamic_keymap_set_keycode() would */
+    set_keymap({new_key});
+    layer_lookup_cache_invalidate();
+
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(new_key);
+    VERIFY_AND_CLEAR(driver);
+}
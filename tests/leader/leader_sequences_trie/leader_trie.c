@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+// clang-format off
+const leader_sequence_node_t PROGMEM leader_sequences[] = {
+    {KC_A, 3, KC_1},            // A
+        {KC_B, 1, KC_NO},       // A B
+            {KC_C, 0, KC_2},    // A B C
+        {KC_D, 0, KC_3},        // A D
+    {KC_G, 6, KC_NO},           // G
+        {KC_H, 5, KC_NO},       // G H
+            {KC_I, 4, KC_NO},   // G H I
+                {KC_J, 3, KC_NO},
+                    {KC_K, 2, KC_NO},
+                        {KC_L, 1, KC_NO},
+                            {KC_M, 0, LSFT(KC_4)}, // G H I J K L M
+};
+// clang-format on
@@ -0,0 +1,131 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LeaderSequencesTrie : public TestFixture {};
+
+TEST_F(LeaderSequencesTrie, LeafMatchEndsSequenceImmediately) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto       key_d      = KeymapKey(0, 2, 0, KC_D);
+
+    set_keymap({key_leader, key_a, key_d});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(leader_sequence_active(), true);
+    EXPECT_EQ(leader_sequence_result(), KC_1);
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderSequencesTrie, PrefixMatchWaitsForTimeout) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_a      = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_leader, key_a});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderSequencesTrie, InnerNodeWithoutResultSendsNothing) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto       key_b      = KeymapKey(0, 2, 0, KC_B);
+    auto       key_c      = KeymapKey(0, 3, 0, KC_C);
+
+    set_keymap({key_leader, key_a, key_b, key_c});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_b);
+    EXPECT_EQ(leader_sequence_result(), KC_NO);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequencesTrie, UnknownSequenceSendsNothing) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto       key_z      = KeymapKey(0, 2, 0, KC_Z);
+
+    set_keymap({key_leader, key_a, key_z});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_z);
+    tap_key(key_a);
+    EXPECT_EQ(leader_sequence_result(), KC_NO);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequencesTrie, SequencesLongerThanFiveKeys) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_g      = KeymapKey(0, 1, 0, KC_G);
+    auto       key_h      = KeymapKey(0, 2, 0, KC_H);
+    auto       key_i      = KeymapKey(0, 3, 0, KC_I);
+    auto       key_j      = KeymapKey(0, 4, 0, KC_J);
+    auto       key_k      = KeymapKey(0, 5, 0, KC_K);
+    auto       key_l      = KeymapKey(0, 6, 0, KC_L);
+    auto       key_m      = KeymapKey(0, 7, 0, KC_M);
+
+    set_keymap({key_leader, key_g, key_h, key_i, key_j, key_k, key_l, key_m});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_keys(key_g, key_h, key_i, key_j, key_k, key_l);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_4));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_m);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(leader_sequence_active(), false);
+}
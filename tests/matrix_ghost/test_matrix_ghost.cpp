@@ -0,0 +1,133 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+// Ghost detection reads the base layer directly, route it to the test keymap
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (!TestFixture::m_this) {
+        return KC_NO;
+    }
+    const KeymapKey *key = TestFixture::m_this->find_key(layer_num, {.col = column, .row = row});
+    return key ? key->code : KC_NO;
+}
+}
+
+class MatrixGhost : public TestFixture {};
+
+TEST_F(MatrixGhost, ghosted_row_is_ignored) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 0, 1, KC_C);
+    auto       key_d = KeymapKey(0, 1, 1, KC_D);
+
+    set_keymap({key_a, key_b, key_c, key_d});
+    keyboard_update_real_keys();
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_D));
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Row 1 now shares two columns with row 0
+    EXPECT_NO_REPORT(driver);
+    key_c.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_D));
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixGhost, blank_keys_do_not_ghost) {
+    TestDriver driver;
+    auto       key_a     = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b     = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c     = KeymapKey(0, 0, 1, KC_C);
+    auto       key_blank = KeymapKey(0, 1, 1, KC_NO);
+
+    set_keymap({key_a, key_b, key_c, key_blank});
+    keyboard_update_real_keys();
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    key_b.press();
+    key_blank.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_c.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_blank.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixGhost, real_keys_follow_keymap_updates) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 0, 1, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+    keyboard_update_real_keys();
+
+    // The blank key at (1, 1) is remapped without rebuilding the whole mask
+    auto key_d = KeymapKey(0, 1, 1, KC_D);
+    add_key(key_d);
+    keyboard_update_real_key(1, 1, true);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_D));
+    key_a.press();
+    key_b.press();
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_c.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_D));
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
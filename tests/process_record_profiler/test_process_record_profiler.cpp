@@ -0,0 +1,144 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+// Generous, as the host clock also counts the mocked report sending
+constexpr timestamp_t EVENT_BUDGET = TIMESTAMP_FREQUENCY / 1000;
+
+class ProcessRecordProfiler : public TestFixture {
+   protected:
+    void SetUp() override {
+        process_record_profiler_reset();
+    }
+
+    process_record_profiler_stats_t stats_for(const char *name) {
+        for (uint8_t slot = 0; slot < process_record_profiler_slot_count(); slot++) {
+            if (strcmp(process_record_profiler_get_slot_name(slot), name) == 0) {
+                return process_record_profiler_get_stats(slot);
+            }
+        }
+        ADD_FAILURE() << "no process_record profiler slot named " << name;
+        return {};
+    }
+};
+
+TEST_F(ProcessRecordProfiler, RangedProcessorsAreSkippedForOtherKeycodes) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    // Processors that see every key get both the press and the release
+    EXPECT_EQ(stats_for("kb").calls, 2);
+    EXPECT_EQ(stats_for("kb").skips, 0);
+    EXPECT_EQ(stats_for("caps_word").calls, 2);
+
+    EXPECT_EQ(stats_for("grave_esc").calls, 0);
+    EXPECT_EQ(stats_for("grave_esc").skips, 2);
+    EXPECT_EQ(stats_for("tri_layer").calls, 0);
+    EXPECT_EQ(stats_for("tri_layer").skips, 2);
+    EXPECT_EQ(stats_for("magic").calls, 0);
+    EXPECT_EQ(stats_for("magic").skips, 2);
+
+    // The counts are the ones PROCESS_RECORD_STATS keeps
+    for (uint8_t stage = 0; stage < process_record_stage_count(); stage++) {
+        const process_record_profiler_stats_t stats = process_record_profiler_get_stats(PROCESS_RECORD_SLOT_STAGES + stage);
+        EXPECT_EQ(stats.calls, process_record_get_stats(stage)->calls);
+        EXPECT_EQ(stats.skips, process_record_get_stats(stage)->skips);
+    }
+}
+
+TEST_F(ProcessRecordProfiler, RangedProcessorsReceiveTheirOwnKeycodes) {
+    TestDriver driver;
+    InSequence s;
+    auto       lower_key = KeymapKey(0, 0, 0, TL_LOWR);
+    auto       magic_key = KeymapKey(0, 1, 0, QK_MAGIC_TOGGLE_NKRO);
+
+    set_keymap({lower_key, magic_key});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(lower_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(stats_for("tri_layer").calls, 2);
+    EXPECT_EQ(stats_for("grave_esc").skips, 2);
+
+    // Magic keycodes only act on press
+    EXPECT_NO_REPORT(driver);
+    tap_key(magic_key);
+    VERIFY_AND_CLEAR(driver);
+    keymap_config.nkro = false;
+
+    EXPECT_EQ(stats_for("magic").calls, 1);
+    EXPECT_EQ(stats_for("magic").skips, 3);
+}
+
+TEST_F(ProcessRecordProfiler, EveryEventIsTimedWithinBudget) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    const process_record_profiler_stats_t handlers = process_record_profiler_get_stats(PROCESS_RECORD_SLOT_HANDLERS);
+    EXPECT_EQ(handlers.calls, 4);
+    EXPECT_LE(handlers.max, EVENT_BUDGET);
+    EXPECT_LE(handlers.ticks, 4 * (uint64_t)EVENT_BUDGET);
+
+    // The default process_record_kb() times process_record_user() on its own
+    const process_record_profiler_stats_t user = process_record_profiler_get_stats(PROCESS_RECORD_SLOT_USER);
+    EXPECT_EQ(user.calls, 4);
+    EXPECT_LE(user.ticks, stats_for("kb").ticks);
+
+    // The chain as a whole covers each processor in it
+    EXPECT_GE(handlers.ticks, stats_for("kb").ticks + stats_for("caps_word").ticks);
+}
+
+TEST_F(ProcessRecordProfiler, RawHidReportsStats) {
+    process_record_profiler_record(PROCESS_RECORD_SLOT_USER, 5);
+    process_record_profiler_record(PROCESS_RECORD_SLOT_USER, 7);
+
+    uint8_t data[32] = {PROCESS_RECORD_PROFILER_RAW_HID_COMMAND_ID, process_record_profiler_raw_hid_get_stats, PROCESS_RECORD_SLOT_USER};
+    EXPECT_TRUE(process_record_profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], process_record_profiler_raw_hid_get_stats);
+    EXPECT_EQ(data[3 + 4], 2);   // calls
+    EXPECT_EQ(data[3 + 8], 0);   // skips
+    EXPECT_EQ(data[3 + 12], 7);  // max
+    EXPECT_EQ(data[3 + 16], 12); // ticks
+
+    uint8_t name[32] = {PROCESS_RECORD_PROFILER_RAW_HID_COMMAND_ID, process_record_profiler_raw_hid_get_slot_name, PROCESS_RECORD_SLOT_STAGES};
+    EXPECT_TRUE(process_record_profiler_raw_hid_receive(name, sizeof(name)));
+    EXPECT_STREQ((const char *)&name[3], process_record_stage_name(0));
+
+    uint8_t invalid[32] = {PROCESS_RECORD_PROFILER_RAW_HID_COMMAND_ID, process_record_profiler_raw_hid_get_stats, process_record_profiler_slot_count()};
+    EXPECT_TRUE(process_record_profiler_raw_hid_receive(invalid, sizeof(invalid)));
+    EXPECT_EQ(invalid[1], 0xFF);
+
+    uint8_t other[32] = {0x01};
+    EXPECT_FALSE(process_record_profiler_raw_hid_receive(other, sizeof(other)));
+}
@@ -0,0 +1,80 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ProcessRecordStats : public TestFixture {
+   protected:
+    void SetUp() override {
+        process_record_stats_reset();
+    }
+
+    const process_record_stats_t *stats_for(const char *name) {
+        for (uint8_t stage = 0; stage < process_record_stage_count(); stage++) {
+            if (strcmp(process_record_stage_name(stage), name) == 0) {
+                return process_record_get_stats(stage);
+            }
+        }
+        ADD_FAILURE() << "no process_record stage named " << name;
+        return nullptr;
+    }
+};
+
+TEST_F(ProcessRecordStats, RangedProcessorsAreSkippedForOtherKeycodes) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    // Processors that see every key get both the press and the release
+    EXPECT_EQ(stats_for("kb")->calls, 2);
+    EXPECT_EQ(stats_for("kb")->skips, 0);
+    EXPECT_EQ(stats_for("caps_word")->calls, 2);
+
+    EXPECT_EQ(stats_for("grave_esc")->calls, 0);
+    EXPECT_EQ(stats_for("grave_esc")->skips, 2);
+    EXPECT_EQ(stats_for("tri_layer")->calls, 0);
+    EXPECT_EQ(stats_for("tri_layer")->skips, 2);
+    EXPECT_EQ(stats_for("magic")->calls, 0);
+    EXPECT_EQ(stats_for("magic")->skips, 2);
+}
+
+TEST_F(ProcessRecordStats, RangedProcessorsReceiveTheirOwnKeycodes) {
+    TestDriver driver;
+    InSequence s;
+    auto       lower_key = KeymapKey(0, 0, 0, TL_LOWR);
+    auto       magic_key = KeymapKey(0, 1, 0, QK_MAGIC_TOGGLE_NKRO);
+
+    set_keymap({lower_key, magic_key});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(lower_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(stats_for("tri_layer")->calls, 2);
+    EXPECT_EQ(stats_for("grave_esc")->skips, 2);
+
+    // Magic keycodes only act on press
+    EXPECT_NO_REPORT(driver);
+    tap_key(magic_key);
+    VERIFY_AND_CLEAR(driver);
+    keymap_config.nkro = false;
+
+    EXPECT_EQ(stats_for("magic")->calls, 1);
+    EXPECT_EQ(stats_for("magic")->skips, 3);
+}
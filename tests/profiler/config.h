@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define PROFILER_USER_SLOT_COUNT 1
+#define PROFILER_HISTOGRAM_BUCKETS 8
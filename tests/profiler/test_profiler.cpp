@@ -0,0 +1,90 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class Profiler : public TestFixture {
+   public:
+    void SetUp() override {
+        profiler_reset();
+    }
+};
+
+TEST_F(Profiler, scan_loop_populates_core_slots) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_NO_REPORT(driver);
+    for (int i = 0; i < 10; i++) {
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(profiler_get_stats(PROFILER_SLOT_KEYBOARD_TASK)->count, 10);
+    EXPECT_EQ(profiler_get_stats(PROFILER_SLOT_MATRIX_TASK)->count, 10);
+    EXPECT_EQ(profiler_get_stats(PROFILER_SLOT_QUANTUM_TASK)->count, 10);
+    EXPECT_EQ(profiler_get_stats(PROFILER_SLOT_OLED_TASK)->count, 0);
+
+    // The outer slot always covers the nested ones
+    EXPECT_GE(profiler_get_stats(PROFILER_SLOT_KEYBOARD_TASK)->total, profiler_get_stats(PROFILER_SLOT_MATRIX_TASK)->total);
+}
+
+TEST_F(Profiler, record_tracks_min_max_mean) {
+    profiler_record(PROFILER_SLOT_USER, 10);
+    profiler_record(PROFILER_SLOT_USER, 30);
+    profiler_record(PROFILER_SLOT_USER, 20);
+
+    const profiler_stats_t *stats = profiler_get_stats(PROFILER_SLOT_USER);
+    EXPECT_EQ(stats->count, 3);
+    EXPECT_EQ(stats->min, 10);
+    EXPECT_EQ(stats->max, 30);
+    EXPECT_EQ(profiler_get_mean(PROFILER_SLOT_USER), 20);
+}
+
+TEST_F(Profiler, histogram_buckets_are_log2) {
+    profiler_record(PROFILER_SLOT_USER, 0);
+    profiler_record(PROFILER_SLOT_USER, 1);
+    profiler_record(PROFILER_SLOT_USER, 2);
+    profiler_record(PROFILER_SLOT_USER, 3);
+    profiler_record(PROFILER_SLOT_USER, 64);
+    profiler_record(PROFILER_SLOT_USER, 100000);
+
+    const profiler_stats_t *stats = profiler_get_stats(PROFILER_SLOT_USER);
+    EXPECT_EQ(stats->histogram[0], 1);
+    EXPECT_EQ(stats->histogram[1], 1);
+    EXPECT_EQ(stats->histogram[2], 2);
+    EXPECT_EQ(stats->histogram[7], 2); // 64 needs 7 bits, larger values saturate
+}
+
+TEST_F(Profiler, unknown_slots_are_ignored) {
+    profiler_record(PROFILER_SLOT_COUNT, 10);
+    EXPECT_EQ(profiler_get_stats(PROFILER_SLOT_COUNT), nullptr);
+    EXPECT_EQ(profiler_get_slot_name(PROFILER_SLOT_COUNT), nullptr);
+    EXPECT_STREQ(profiler_get_slot_name(PROFILER_SLOT_MATRIX_TASK), "matrix_task");
+    EXPECT_STREQ(profiler_get_slot_name(PROFILER_SLOT_USER), "user");
+}
+
+TEST_F(Profiler, raw_hid_reports_stats) {
+    profiler_record(PROFILER_SLOT_USER, 5);
+    profiler_record(PROFILER_SLOT_USER, 7);
+
+    uint8_t data[32] = {PROFILER_RAW_HID_COMMAND_ID, profiler_raw_hid_get_stats, PROFILER_SLOT_USER};
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], profiler_raw_hid_get_stats);
+    EXPECT_EQ(data[3 + 4], 2); // count
+    EXPECT_EQ(data[3 + 8], 5); // min
+    EXPECT_EQ(data[3 + 12], 7); // max
+    EXPECT_EQ(data[3 + 16], 6); // mean
+
+    uint8_t histogram[32] = {PROFILER_RAW_HID_COMMAND_ID, profiler_raw_hid_get_histogram, PROFILER_SLOT_USER, 0};
+    EXPECT_TRUE(profiler_raw_hid_receive(histogram, sizeof(histogram)));
+    EXPECT_EQ(histogram[4], PROFILER_HISTOGRAM_BUCKETS);
+    EXPECT_EQ(histogram[5 + 3 * 2], 2); // both samples need 3 bits
+
+    uint8_t other[32] = {0x01};
+    EXPECT_FALSE(profiler_raw_hid_receive(other, sizeof(other)));
+}
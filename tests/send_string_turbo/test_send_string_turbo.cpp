@@ -0,0 +1,268 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+namespace {
+
+// The characters the tests type, with the key and Shift state each one takes
+// on a US layout
+std::map<std::pair<uint8_t, bool>, char> typed_chars(void) {
+    std::map<std::pair<uint8_t, bool>, char> chars;
+    for (char c = ' '; c <= '~'; c++) {
+        const uint8_t keycode = ascii_to_keycode_lut[(uint8_t)c];
+        const bool    shifted = (ascii_to_shift_lut[c / 8] >> (c % 8)) & 1;
+        chars[{keycode, shifted}] = c;
+    }
+    chars[{KC_ENTER, false}] = '\n';
+    return chars;
+}
+
+// Stands in for the host, turning the reports back into text. Keys newly
+// pressed in a report are taken in keycode order, as a host reading the
+// report as a bitmap would, and must also appear in that order in the report
+// for a host reading it as an array.
+class Host {
+   public:
+    std::string text;
+    size_t      reports      = 0;
+    bool        out_of_order = false;
+
+    void receive(const report_keyboard_t &report) {
+        reports++;
+
+        std::vector<uint8_t> pressed;
+        for (uint8_t key : report.keys) {
+            if (key && !held(key)) {
+                if (!pressed.empty() && key < pressed.back()) {
+                    out_of_order = true;
+                }
+                pressed.push_back(key);
+            }
+        }
+        std::sort(pressed.begin(), pressed.end());
+
+        const bool shifted = report.mods & (MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_RIGHT_SHIFT));
+        for (uint8_t key : pressed) {
+            auto c = chars.find({key, shifted});
+            text += c == chars.end() ? '?' : c->second;
+        }
+        last = report;
+    }
+
+   private:
+    std::map<std::pair<uint8_t, bool>, char> chars = typed_chars();
+    report_keyboard_t                        last  = {};
+
+    bool held(uint8_t key) const {
+        for (uint8_t last_key : last.keys) {
+            if (last_key == key) return true;
+        }
+        return false;
+    }
+};
+
+std::string boilerplate(void) {
+    const std::string header =
+        "/* Copyright 2024 QMK\n"
+        " *\n"
+        " * This program is free software: you can redistribute it and/or modify\n"
+        " * it under the terms of the GNU General Public License as published by\n"
+        " * the Free Software Foundation, either version 2 of the License, or\n"
+        " * (at your option) any later version.\n"
+        " */\n"
+        "#include QMK_KEYBOARD_H\n"
+        "const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {\n"
+        "    [0] = LAYOUT(KC_A, KC_B, KC_C, KC_D),\n"
+        "};\n";
+
+    std::string text;
+    while (text.size() < 2048) {
+        text += header;
+    }
+    return text;
+}
+
+std::string random_text(uint32_t seed, size_t length) {
+    std::mt19937                       rng(seed);
+    std::uniform_int_distribution<int> dist(' ', '~');
+
+    std::string text;
+    for (size_t i = 0; i < length; i++) {
+        text += (char)dist(rng);
+    }
+    return text;
+}
+
+} // namespace
+
+class SendStringTurbo : public TestFixture {
+   protected:
+    // Types out `text` with `send`, returning what the host made of it
+    template <typename F>
+    Host type(TestDriver &driver, F send) {
+        Host host;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&host](report_keyboard_t &report) { host.receive(report); }));
+        send();
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return host;
+    }
+};
+
+TEST_F(SendStringTurbo, AscendingKeysShareAReport) {
+    TestDriver driver;
+    testing::InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING_TURBO("abc");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringTurbo, RepeatsAndDescendingKeysAreSplit) {
+    TestDriver driver;
+    testing::InSequence s;
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING_TURBO("babb");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringTurbo, ModifierChangesAreSplit) {
+    TestDriver driver;
+    testing::InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B, KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING_TURBO("aBC");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringTurbo, BatchesFitTheReport) {
+    TestDriver driver;
+    testing::InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E, KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_G, KC_H));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING_TURBO("abcdefgh");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringTurbo, BatchesFitAroundHeldKeys) {
+    TestDriver driver;
+    testing::InSequence s;
+    KeymapKey  key_x(0, 0, 0, KC_X);
+    set_keymap({key_x});
+
+    EXPECT_REPORT(driver, (KC_X));
+    key_x.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_X, KC_A, KC_B, KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_REPORT(driver, (KC_X, KC_F, KC_G));
+    EXPECT_REPORT(driver, (KC_X));
+    SEND_STRING_TURBO("abcdefg");
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_x.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringTurbo, HeldKeyIsTypedLikeSendString) {
+    TestDriver driver;
+    testing::InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The batch before it is sent first, then the held key goes through
+    // send_char(), which releases it to press it again, just as it would
+    // with send_string()
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING_TURBO("bac");
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringTurbo, SendStringKeycodesKeepTheirPlace) {
+    TestDriver driver;
+    testing::InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_REPORT(driver, (KC_LCTL, KC_A));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C, KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING_TURBO("ab" SS_LCTL("a") "cd");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringTurbo, RoundTripsBoilerplate) {
+    TestDriver        driver;
+    const std::string text = boilerplate();
+
+    const Host plain = type(driver, [&text] { send_string(text.c_str()); });
+    const Host turbo = type(driver, [&text] { send_string_turbo(text.c_str()); });
+
+    EXPECT_EQ(plain.text, text);
+    EXPECT_EQ(turbo.text, text);
+    EXPECT_FALSE(turbo.out_of_order);
+    EXPECT_LT(turbo.reports, plain.reports);
+    printf("%zu characters: %zu reports with send_string(), %zu with send_string_turbo()\n", text.size(), plain.reports, turbo.reports);
+}
+
+TEST_F(SendStringTurbo, RoundTripsRandomText) {
+    TestDriver driver;
+
+    for (uint32_t seed = 0x514B; seed < 0x514B + 16; seed++) {
+        const std::string text  = random_text(seed, 256);
+        const Host        turbo = type(driver, [&text] { send_string_turbo(text.c_str()); });
+
+        EXPECT_EQ(turbo.text, text) << "seed " << seed;
+        EXPECT_FALSE(turbo.out_of_order) << "seed " << seed;
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+task_schedule_t task_scheduler_get_schedule_user(scheduled_task_t task, task_schedule_t schedule) {
+    switch (task) {
+        case SCHEDULED_TASK_OLED:
+            schedule.period = 10;
+            break;
+        case SCHEDULED_TASK_RGB_MATRIX:
+            schedule.budget = 10;
+            break;
+        default:
+            break;
+    }
+    return schedule;
+}
+}
+
+// Burn real time, as measured by the platform timestamp
+static void busy_wait_us(uint32_t us) {
+    const timestamp_t start = timestamp_read();
+    while (TIMESTAMP_TO_US(TIMESTAMP_DIFF(timestamp_read(), start)) < us) {
+    }
+}
+
+static bool run_task(scheduled_task_t task, uint32_t cost_us) {
+    bool ran = false;
+    SCHEDULED_TASK(task, {
+        busy_wait_us(cost_us);
+        ran = true;
+    });
+    return ran;
+}
+
+class TaskScheduler : public TestFixture {
+   public:
+    void SetUp() override {
+        task_scheduler_init();
+    }
+};
+
+TEST_F(TaskScheduler, period_limits_run_rate) {
+    TestDriver driver;
+
+    task_scheduler_loop_begin();
+    EXPECT_FALSE(run_task(SCHEDULED_TASK_OLED, 0));
+
+    idle_for(10);
+    task_scheduler_loop_begin();
+    EXPECT_TRUE(run_task(SCHEDULED_TASK_OLED, 0));
+    task_scheduler_loop_begin();
+    EXPECT_FALSE(run_task(SCHEDULED_TASK_OLED, 0));
+
+    EXPECT_EQ(task_scheduler_get_stats(SCHEDULED_TASK_OLED)->runs, 1);
+    EXPECT_EQ(task_scheduler_get_stats(SCHEDULED_TASK_OLED)->deferrals, 0);
+}
+
+TEST_F(TaskScheduler, expensive_task_is_deferred_when_over_budget) {
+    TestDriver driver;
+
+    task_scheduler_loop_begin();
+    EXPECT_TRUE(run_task(SCHEDULED_TASK_QUANTUM_PAINTER, 100));
+
+    // Its expected cost no longer fits in the loop budget
+    task_scheduler_loop_begin();
+    EXPECT_FALSE(run_task(SCHEDULED_TASK_QUANTUM_PAINTER, 100));
+    EXPECT_EQ(task_scheduler_get_stats(SCHEDULED_TASK_QUANTUM_PAINTER)->deferrals, 1);
+
+    // ... until it has been starved for too long
+    idle_for(TASK_SCHEDULER_MAX_DEFER);
+    task_scheduler_loop_begin();
+    EXPECT_TRUE(run_task(SCHEDULED_TASK_QUANTUM_PAINTER, 100));
+    EXPECT_EQ(task_scheduler_get_stats(SCHEDULED_TASK_QUANTUM_PAINTER)->runs, 2);
+}
+
+TEST_F(TaskScheduler, higher_priority_tasks_are_reserved_time) {
+    TestDriver driver;
+
+    // Teach the scheduler that RGB matrix is moderately expensive
+    task_scheduler_loop_begin();
+    EXPECT_TRUE(run_task(SCHEDULED_TASK_RGB_MATRIX, 30));
+
+    // Fits alongside RGB matrix while the painter's cost is still unknown
+    task_scheduler_loop_begin();
+    EXPECT_TRUE(run_task(SCHEDULED_TASK_QUANTUM_PAINTER, 25));
+
+    // Now both no longer fit, so the lower priority painter gives way
+    task_scheduler_loop_begin();
+    EXPECT_FALSE(run_task(SCHEDULED_TASK_QUANTUM_PAINTER, 25));
+    EXPECT_TRUE(run_task(SCHEDULED_TASK_RGB_MATRIX, 30));
+    EXPECT_EQ(task_scheduler_get_stats(SCHEDULED_TASK_QUANTUM_PAINTER)->deferrals, 1);
+    EXPECT_EQ(task_scheduler_get_stats(SCHEDULED_TASK_RGB_MATRIX)->deferrals, 0);
+}
+
+TEST_F(TaskScheduler, overruns_are_counted) {
+    TestDriver driver;
+
+    task_scheduler_loop_begin();
+    EXPECT_TRUE(run_task(SCHEDULED_TASK_RGB_MATRIX, 20));
+    EXPECT_EQ(task_scheduler_get_stats(SCHEDULED_TASK_RGB_MATRIX)->overruns, 1);
+
+    busy_wait_us(TASK_SCHEDULER_LOOP_BUDGET);
+    task_scheduler_loop_begin();
+    EXPECT_EQ(task_scheduler_loop_overruns(), 1);
+}
@@ -0,0 +1,18 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TAPPING_TERM 200
+
+#define THROUGHPUT_MAX_COMBOS 1000
+
+// Host CPU time allowed per key event, on average and at worst, through
+// action_exec() with the largest combo set
+#define THROUGHPUT_MEAN_EVENT_BUDGET_NS 100000
+#define THROUGHPUT_MAX_EVENT_BUDGET_NS 2000000
+// Key events per second of host CPU time the pipeline must sustain, ticks and
+// combo_task() included
+#define THROUGHPUT_MIN_EVENTS_PER_SECOND 10000
@@ -0,0 +1,222 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+extern "C" {
+extern const uint16_t throughput_keycodes[MATRIX_ROWS][MATRIX_COLS];
+
+void throughput_combos_init(uint32_t seed);
+void advance_time(uint32_t ms);
+}
+
+// Only the first active_combos of the generated combos take part
+static uint16_t active_combos = 0;
+
+extern "C" uint16_t combo_count(void) {
+    return active_combos;
+}
+
+namespace {
+
+// Keystrokes per run, at 150-250 WPM of five characters per word
+constexpr uint32_t KEYSTROKES  = 2000;
+constexpr uint32_t MIN_WPM     = 150;
+constexpr uint32_t MAX_WPM     = 250;
+constexpr uint32_t MIN_HOLD_MS = 40;
+constexpr uint32_t MAX_HOLD_MS = 140;
+// Share of keystrokes held past the tapping term, so mod-taps also resolve as
+// holds
+constexpr double LONG_HOLD_CHANCE = 0.05;
+
+struct Event {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+// Overlapping presses of the alphas and thumb keys, as rolled by a fast typist
+std::vector<Event> generate_rolls(uint32_t seed) {
+    std::mt19937                            rng(seed);
+    std::uniform_real_distribution<double>  chance(0, 1);
+    std::uniform_int_distribution<uint32_t> wpm_dist(MIN_WPM, MAX_WPM);
+    std::uniform_int_distribution<uint32_t> hold_dist(MIN_HOLD_MS, MAX_HOLD_MS);
+    std::uniform_int_distribution<uint32_t> alpha_dist(0, 3 * MATRIX_COLS - 1);
+    std::uniform_int_distribution<uint32_t> thumb_dist(3, 6);
+
+    std::vector<Event>    events;
+    std::vector<uint32_t> released_at(MATRIX_ROWS * MATRIX_COLS, 0);
+    uint32_t              time = 1;
+
+    for (uint32_t keystroke = 0; keystroke < KEYSTROKES; keystroke++) {
+        time += 60000 / (wpm_dist(rng) * 5);
+
+        uint32_t key;
+        do {
+            key = chance(rng) < 0.15 ? 3 * MATRIX_COLS + thumb_dist(rng) : alpha_dist(rng);
+        } while (released_at[key] >= time);
+
+        const uint32_t hold = chance(rng) < LONG_HOLD_CHANCE ? TAPPING_TERM + hold_dist(rng) : hold_dist(rng);
+        released_at[key]    = time + hold;
+        events.push_back({time, (uint8_t)(key / MATRIX_COLS), (uint8_t)(key % MATRIX_COLS), true});
+        events.push_back({time + hold, (uint8_t)(key / MATRIX_COLS), (uint8_t)(key % MATRIX_COLS), false});
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return a.time < b.time; });
+    return events;
+}
+
+// MAKE_KEYEVENT() and MAKE_TICK_EVENT use C designated initializers
+keyevent_t make_event(keyevent_type_t type, uint8_t row, uint8_t col, bool pressed) {
+    keyevent_t event = {};
+    event.key.row    = row;
+    event.key.col    = col;
+    event.time       = timer_read();
+    event.type       = type;
+    event.pressed    = pressed;
+    return event;
+}
+
+uint64_t cpu_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+// Counts reports instead of handing them to the mocked driver, whose
+// bookkeeping would otherwise dominate the timings
+uint32_t reports_sent = 0;
+
+uint8_t counting_keyboard_leds(void) {
+    return 0;
+}
+
+void counting_send_keyboard(report_keyboard_t *report) {
+    reports_sent++;
+}
+
+void counting_send_nkro(report_nkro_t *report) {
+    reports_sent++;
+}
+
+void counting_send_mouse(report_mouse_t *report) {
+    reports_sent++;
+}
+
+void counting_send_extra(report_extra_t *report) {
+    reports_sent++;
+}
+
+host_driver_t counting_driver = {counting_keyboard_leds, counting_send_keyboard, counting_send_nkro, counting_send_mouse, counting_send_extra};
+
+struct Result {
+    uint32_t key_events;
+    uint32_t reports;
+    uint64_t event_ns;
+    uint64_t max_event_ns;
+    uint64_t pipeline_ns;
+};
+
+} // namespace
+
+class Throughput : public TestFixture {
+   protected:
+    void SetUp() override {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, throughput_keycodes[row][col]));
+                // The layers of the layer-tap keys fall through to the base layer
+                add_key(KeymapKey(1, col, row, KC_TRNS));
+                add_key(KeymapKey(2, col, row, KC_TRNS));
+            }
+        }
+    }
+
+    // Replays the events straight into action_exec(), one millisecond at a
+    // time, with the tick events and combo_task() that keyboard_task() would
+    // add in between
+    Result run(const std::vector<Event> &events) {
+        Result         result = {};
+        auto           next   = events.begin();
+        bool           idle   = false;
+        host_driver_t *driver = host_get_driver();
+
+        host_set_driver(&counting_driver);
+        reports_sent = 0;
+
+        while (next != events.end() || !idle) {
+            advance_time(1);
+            const uint32_t now = timer_read32();
+
+            uint64_t start = cpu_time_ns();
+            if (next != events.end() && next->time <= now) {
+                for (; next != events.end() && next->time <= now; next++) {
+                    const uint64_t event_start = cpu_time_ns();
+                    action_exec(make_event(KEY_EVENT, next->row, next->col, next->pressed));
+                    const uint64_t event_ns = cpu_time_ns() - event_start;
+
+                    result.key_events++;
+                    result.event_ns += event_ns;
+                    result.max_event_ns = std::max(result.max_event_ns, event_ns);
+                }
+            } else {
+                action_exec(make_event(TICK_EVENT, 0, 0, false));
+            }
+            combo_task();
+            result.pipeline_ns += cpu_time_ns() - start;
+
+            // Let the last release settle before stopping
+            if (next == events.end()) {
+                idle = now > events.back().time + TAPPING_TERM * 2;
+            }
+        }
+
+        host_set_driver(driver);
+        result.reports = reports_sent;
+        return result;
+    }
+};
+
+TEST_F(Throughput, CombosAndModTaps) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    const std::vector<Event> events = generate_rolls(0x514B);
+    throughput_combos_init(0x514B);
+
+    // Warm up, so the first row isn't charged for cold caches
+    run(events);
+
+    printf("%u keystrokes at %u-%u WPM, %u mod-tap and layer-tap keys\n", KEYSTROKES, MIN_WPM, MAX_WPM, 12);
+    printf("%8s %10s %10s %12s %12s %14s\n", "combos", "events", "reports", "ns/event", "max ns", "events/s");
+    for (uint16_t combos : {0, 10, 100, THROUGHPUT_MAX_COMBOS}) {
+        active_combos       = combos;
+        const Result result = run(events);
+
+        const double mean_ns    = (double)result.event_ns / result.key_events;
+        const double per_second = result.key_events * 1e9 / result.pipeline_ns;
+        printf("%8u %10u %10u %12.0f %12lu %14.0f\n", combos, result.key_events, result.reports, mean_ns, (unsigned long)result.max_event_ns, per_second);
+
+        EXPECT_EQ(result.key_events, events.size());
+        EXPECT_FALSE(has_anykey()) << "keys left registered with " << combos << " combos";
+        EXPECT_EQ(get_mods(), 0) << "mods left registered with " << combos << " combos";
+
+        EXPECT_LE(mean_ns, THROUGHPUT_MEAN_EVENT_BUDGET_NS) << "action_exec() is too slow on average with " << combos << " combos";
+        EXPECT_LE(result.max_event_ns, THROUGHPUT_MAX_EVENT_BUDGET_NS) << "action_exec() took too long for a single event with " << combos << " combos";
+        EXPECT_GE(per_second, THROUGHPUT_MIN_EVENTS_PER_SECOND) << "pipeline cannot sustain the required event rate with " << combos << " combos";
+    }
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,37 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+// clang-format off
+const uint16_t throughput_keycodes[MATRIX_ROWS][MATRIX_COLS] = {
+    {KC_Q,         KC_W,         KC_E,         KC_R,         KC_T,    KC_Y,    KC_U,         KC_I,         KC_O,         KC_P},
+    {LGUI_T(KC_A), LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G,    KC_H,    RSFT_T(KC_J), RCTL_T(KC_K), RALT_T(KC_L), RGUI_T(KC_SCLN)},
+    {KC_Z,         KC_X,         KC_C,         KC_V,         KC_B,    KC_N,    KC_M,         KC_COMM,      KC_DOT,       KC_SLSH},
+    {KC_NO,        KC_NO,        KC_NO,        LT(1, KC_TAB), SFT_T(KC_SPC), CTL_T(KC_ENT), LT(2, KC_BSPC), KC_NO, KC_NO,     KC_NO},
+};
+// clang-format on
+
+// Combos of two or three of the alphas, rebuilt by throughput_combos_init()
+static uint16_t throughput_combo_keys[THROUGHPUT_MAX_COMBOS][4];
+combo_t         key_combos[THROUGHPUT_MAX_COMBOS];
+
+void throughput_combos_init(uint32_t seed) {
+    for (uint16_t i = 0; i < THROUGHPUT_MAX_COMBOS; i++) {
+        uint16_t *keys = throughput_combo_keys[i];
+        uint8_t   size = 2 + (seed >> 16) % 2;
+        for (uint8_t k = 0; k < size; k++) {
+            bool repeated;
+            do {
+                seed             = seed * 1103515245 + 12345;
+                uint8_t position = (seed >> 16) % (3 * MATRIX_COLS);
+                keys[k]          = throughput_keycodes[position / MATRIX_COLS][position % MATRIX_COLS];
+                repeated         = false;
+                for (uint8_t j = 0; j < k; j++) {
+                    repeated |= keys[j] == keys[k];
+                }
+            } while (repeated);
+        }
+        keys[size]    = COMBO_END;
+        key_combos[i] = (combo_t)COMBO(keys, KC_F1 + i % 12);
+    }
+}
@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define VIA_BULK_TRANSFER
+#define DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE 16
+#define DYNAMIC_KEYMAP_LAYER_COUNT 4
+#define DYNAMIC_KEYMAP_MACRO_COUNT 2
+#define TRANSIENT_EEPROM_SIZE 1024
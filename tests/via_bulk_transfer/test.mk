@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+VIA_ENABLE = yes
+# The test harness EEPROM is too small to hold a keymap
+EEPROM_DRIVER = transient
@@ -0,0 +1,223 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+void raw_hid_receive(uint8_t *data, uint8_t length);
+}
+
+typedef std::vector<uint8_t>         Packet;
+typedef std::pair<uint16_t, uint16_t> Change;
+
+// Where the host's copy of the keymap stands: an epoch and a generation
+typedef std::pair<uint16_t, uint16_t> Position;
+
+// Stands in for the host end of the raw HID interface
+static std::vector<Packet> sent_packets;
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    sent_packets.push_back(Packet(data, data + length));
+}
+
+namespace {
+
+constexpr uint8_t  PACKET_SIZE = 32;
+constexpr uint16_t KEY_COUNT   = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS;
+
+Packet packet(std::initializer_list<uint8_t> bytes) {
+    Packet data(bytes);
+    data.resize(PACKET_SIZE);
+    return data;
+}
+
+std::vector<Packet> send(Packet data) {
+    sent_packets.clear();
+    raw_hid_receive(data.data(), data.size());
+    return sent_packets;
+}
+
+uint16_t keycode_at(uint16_t index) {
+    return dynamic_keymap_get_keycode(index / (MATRIX_ROWS * MATRIX_COLS), (index / MATRIX_COLS) % MATRIX_ROWS, index % MATRIX_COLS);
+}
+
+} // namespace
+
+class ViaBulkTransfer : public TestFixture {
+   protected:
+    std::vector<Packet> get_changes(Position since) {
+        return send(packet({id_dynamic_keymap_get_changes, (uint8_t)(since.first >> 8), (uint8_t)(since.first & 0xFF), (uint8_t)(since.second >> 8), (uint8_t)(since.second & 0xFF)}));
+    }
+
+    Position position(const Packet &reply) {
+        return {(reply[2] << 8) | reply[3], (reply[4] << 8) | reply[5]};
+    }
+
+    Position current(void) {
+        return position(get_changes({0, 0}).back());
+    }
+
+    // Changes reported since the given position, as key index and keycode pairs
+    std::vector<Change> changes_since(Position since, size_t expected_packets) {
+        auto replies = get_changes(since);
+        EXPECT_EQ(replies.size(), expected_packets);
+
+        std::vector<Change> changes;
+        for (size_t i = 0; i < replies.size(); i++) {
+            const Packet &reply = replies[i];
+            EXPECT_EQ(reply[0], id_dynamic_keymap_get_changes);
+            EXPECT_EQ(reply[1], i + 1 == replies.size() ? id_keymap_changes_last : id_keymap_changes_more);
+            for (uint8_t entry = 0; entry < reply[6]; entry++) {
+                const uint8_t *bytes = &reply[7 + entry * 4];
+                changes.push_back({(bytes[0] << 8) | bytes[1], (bytes[2] << 8) | bytes[3]});
+            }
+        }
+        return changes;
+    }
+};
+
+TEST_F(ViaBulkTransfer, BulkReadStreamsTheWholeKeymap) {
+    for (uint16_t index = 0; index < KEY_COUNT; index++) {
+        dynamic_keymap_set_keycode(index / (MATRIX_ROWS * MATRIX_COLS), (index / MATRIX_COLS) % MATRIX_ROWS, index % MATRIX_COLS, 0x1000 + index);
+    }
+
+    const uint16_t size    = KEY_COUNT * 2;
+    auto           replies = send(packet({id_dynamic_keymap_bulk_get_buffer, 0, 0, (uint8_t)(size >> 8), (uint8_t)(size & 0xFF)}));
+
+    const size_t per_packet = PACKET_SIZE - 3;
+    ASSERT_EQ(replies.size(), (size + per_packet - 1) / per_packet);
+
+    std::vector<uint8_t> keymap;
+    for (const Packet &reply : replies) {
+        EXPECT_EQ(reply[0], id_dynamic_keymap_bulk_get_buffer);
+        EXPECT_EQ((reply[1] << 8) | reply[2], keymap.size());
+        keymap.insert(keymap.end(), reply.begin() + 3, reply.end());
+    }
+    for (uint16_t index = 0; index < KEY_COUNT; index++) {
+        EXPECT_EQ((keymap[index * 2] << 8) | keymap[index * 2 + 1], 0x1000 + index) << "key " << index;
+    }
+
+    // The legacy command needs one round trip per 28 bytes
+    printf("%u byte keymap: %zu round trips with id_dynamic_keymap_get_buffer, 1 request and %zu packets streamed with id_dynamic_keymap_bulk_get_buffer\n", size, (size_t)(size + 27) / 28, replies.size());
+}
+
+TEST_F(ViaBulkTransfer, BulkReadStopsAtTheEndOfTheKeymap) {
+    const uint16_t offset  = KEY_COUNT * 2 - 10;
+    auto           replies = send(packet({id_dynamic_keymap_bulk_get_buffer, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), 0xFF, 0xFF}));
+
+    ASSERT_EQ(replies.size(), 1);
+    EXPECT_EQ((replies[0][1] << 8) | replies[0][2], offset);
+
+    uint8_t expected[10];
+    dynamic_keymap_get_buffer(offset, sizeof(expected), expected);
+    EXPECT_EQ(memcmp(&replies[0][3], expected, sizeof(expected)), 0);
+    EXPECT_EQ(replies[0][3 + sizeof(expected)], 0);
+}
+
+TEST_F(ViaBulkTransfer, BulkWriteIsAcknowledgedOnce) {
+    const uint16_t     offset = MATRIX_ROWS * MATRIX_COLS * 2;
+    const uint16_t     size   = 100;
+    std::vector<uint8_t> keys;
+    for (uint16_t i = 0; i < size / 2; i++) {
+        keys.push_back(0x20);
+        keys.push_back(i);
+    }
+
+    Packet first = packet({id_dynamic_keymap_bulk_set_buffer, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), 0, size});
+    std::copy(keys.begin(), keys.begin() + PACKET_SIZE - 5, first.begin() + 5);
+    EXPECT_TRUE(send(first).empty());
+
+    size_t written = PACKET_SIZE - 5;
+    while (written < size) {
+        const uint16_t next   = offset + written;
+        Packet         packet = ::packet({id_dynamic_keymap_bulk_set_buffer_next, (uint8_t)(next >> 8), (uint8_t)(next & 0xFF)});
+        const size_t   chunk  = std::min<size_t>(size - written, PACKET_SIZE - 3);
+        std::copy(keys.begin() + written, keys.begin() + written + chunk, packet.begin() + 3);
+        written += chunk;
+
+        auto replies = send(packet);
+        if (written < size) {
+            EXPECT_TRUE(replies.empty());
+        } else {
+            ASSERT_EQ(replies.size(), 1);
+            EXPECT_EQ(replies[0][0], id_dynamic_keymap_bulk_set_buffer_next);
+        }
+    }
+
+    for (uint16_t i = 0; i < size / 2; i++) {
+        EXPECT_EQ(keycode_at(offset / 2 + i), 0x2000 + i);
+    }
+}
+
+TEST_F(ViaBulkTransfer, BulkWriteIsAbandonedOnMissingPacket) {
+    send(packet({id_dynamic_keymap_bulk_set_buffer, 0, 0, 0, 100}));
+
+    // The packet for offset 27 went missing
+    auto replies = send(packet({id_dynamic_keymap_bulk_set_buffer_next, 0, 27 + 29}));
+    ASSERT_EQ(replies.size(), 1);
+    EXPECT_EQ(replies[0][0], id_unhandled);
+
+    replies = send(packet({id_dynamic_keymap_bulk_set_buffer_next, 0, 27}));
+    ASSERT_EQ(replies.size(), 1);
+    EXPECT_EQ(replies[0][0], id_unhandled);
+}
+
+TEST_F(ViaBulkTransfer, ChangesSinceGenerationOnlyListChangedKeys) {
+    const Position since = current();
+    EXPECT_TRUE(changes_since(since, 1).empty());
+
+    dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+    dynamic_keymap_set_keycode(2, 3, 4, KC_B);
+    dynamic_keymap_set_keycode(0, 1, 2, KC_C);
+    // Writing the same keycode again is not a change
+    dynamic_keymap_set_keycode(2, 3, 4, KC_B);
+    uint8_t keycode[] = {0x00, KC_D};
+    dynamic_keymap_set_buffer((MATRIX_COLS + 5) * 2, sizeof(keycode), keycode);
+
+    auto changes = changes_since(since, 1);
+    ASSERT_EQ(changes.size(), 3);
+    EXPECT_EQ(changes[0], Change((2 * MATRIX_ROWS + 3) * MATRIX_COLS + 4, KC_B));
+    EXPECT_EQ(changes[1], Change(MATRIX_COLS + 2, KC_C));
+    EXPECT_EQ(changes[2], Change(MATRIX_COLS + 5, KC_D));
+
+    EXPECT_TRUE(changes_since(current(), 1).empty());
+}
+
+TEST_F(ViaBulkTransfer, ChangesSpanSeveralPackets) {
+    const Position since = current();
+    for (uint8_t column = 0; column < 10; column++) {
+        dynamic_keymap_set_keycode(1, 0, column, KC_1 + column);
+    }
+
+    auto changes = changes_since(since, 2);
+    ASSERT_EQ(changes.size(), 10);
+    for (uint8_t column = 0; column < 10; column++) {
+        EXPECT_EQ(changes[column].first, MATRIX_ROWS * MATRIX_COLS + column);
+        EXPECT_EQ(changes[column].second, KC_1 + column);
+    }
+}
+
+TEST_F(ViaBulkTransfer, StaleGenerationAsksForFullRead) {
+    const Position since = current();
+    for (uint8_t i = 0; i <= DYNAMIC_KEYMAP_CHANGE_JOURNAL_SIZE; i++) {
+        dynamic_keymap_set_keycode(3, 0, 0, KC_A + i);
+    }
+
+    auto replies = get_changes(since);
+    ASSERT_EQ(replies.size(), 1);
+    EXPECT_EQ(replies[0][1], id_keymap_changes_stale);
+    EXPECT_EQ(position(replies[0]), current());
+
+    // A generation that is not in the journal yet is stale too
+    replies = get_changes({current().first, current().second + 1});
+    EXPECT_EQ(replies[0][1], id_keymap_changes_stale);
+
+    // As is a generation from another power-up, even one that looks recent
+    replies = get_changes({current().first - 1, current().second});
+    EXPECT_EQ(replies[0][1], id_keymap_changes_stale);
+}